@@ -64,20 +64,19 @@ int main(void) {
 
   // clang-format off
   // create a simple square geometry
-  stem::Geometry geometry({
-    {
-      .name = "position",
-      .size = 2,
-      .buffer = stem::FloatBuffer({
-        -1.f, -1.f,
-        1.f, -1.f,
-        // 1.f, 1.f,
-        1.f, 1.f,
-        -1.f, 1.f,
-        // -1.f, -1.f,
-      })
-    }}
-  );
+  stem::Geometry geometry;
+  geometry.setAttribute({
+    .name = "position",
+    .size = 2,
+    .buffer = stem::FloatBuffer({
+      -1.f, -1.f,
+      1.f, -1.f,
+      // 1.f, 1.f,
+      1.f, 1.f,
+      -1.f, 1.f,
+      // -1.f, -1.f,
+    })
+  });
 
   geometry.setIndex(stem::IndexBuffer({ 0, 1, 2, 2, 3, 0 }));
   // clang-format on
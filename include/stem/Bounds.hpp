@@ -0,0 +1,32 @@
+#pragma once
+
+#include <span>
+#include <cstdint>
+
+namespace stem {
+
+/// @brief Stores the axis aligned box & sphere enclosing a set of positions
+struct Bounds {
+  /// @brief The smallest coordinates
+  float min[3] = {0, 0, 0};
+
+  /// @brief The largest coordinates
+  float max[3] = {0, 0, 0};
+
+  /// @brief The sphere center, at the middle of the box
+  float center[3] = {0, 0, 0};
+
+  /// @brief The sphere radius
+  float radius = 0;
+};
+
+/// @brief Computes the bounds of positions with a vectorized min/max pass
+/// @param positions The vertex positions, xyz first in every vertex
+/// @param stride The number of floats between consecutive vertex positions
+/// @return The bounds, zeroed without positions
+Bounds computeBounds(
+  const std::span<const float> positions,
+  const uint32_t stride = 3
+);
+
+} // namespace stem
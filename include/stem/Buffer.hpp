@@ -1,14 +1,74 @@
 #pragma once
 
+#include <span>
+#include <iterator>
+#include <concepts>
+#include <vector>
+#include <utility>
 #include <variant>
 #include <glad/gl.h>
 #include <stem/Error.hpp>
+#include <stem/GLTypeTraits.hpp>
+#include <stem/Capabilities.hpp>
+#include <stem/Exception.hpp>
+#include <stem/DirtyRanges.hpp>
+#include <stem/BufferArena.hpp>
+#include <stem/DeletionQueue.hpp>
 
 namespace stem {
 
-template <uint32_t GLBufferType, uint32_t GLValueType, typename ValueType>
+class BufferRangeError : public Exception {
+public:
+  /// @brief BufferRangeError' class constructor
+  /// @param offset The faulty byte offset
+  /// @param size The faulty byte size
+  /// @param capacity The buffer' byte size
+  /// @return BufferRangeError
+  BufferRangeError(
+    const uint32_t offset,
+    const uint32_t size,
+    const uint32_t capacity
+  );
+};
+
+class ImmutableBufferError : public Exception {
+public:
+  /// @brief ImmutableBufferError' class constructor
+  /// @param id The faulty buffer' OpenGL identifier
+  /// @return ImmutableBufferError
+  ImmutableBufferError(const uint32_t id);
+};
+
+/// @brief Returns whether a gl buffer target has indexed binding points
+/// @param target The gl buffer target
+/// @return Whether the target has indexed binding points
+constexpr bool isIndexedTarget(const uint32_t target) {
+  return target == GL_UNIFORM_BUFFER || target == GL_SHADER_STORAGE_BUFFER ||
+         target == GL_ATOMIC_COUNTER_BUFFER ||
+         target == GL_TRANSFORM_FEEDBACK_BUFFER;
+}
+
+/// @brief Copies bytes between two gl buffers on the gpu
+/// @param source The source gl buffer identifier
+/// @param target The target gl buffer identifier
+/// @param sourceOffset The source byte offset
+/// @param targetOffset The target byte offset
+/// @param size The number of bytes to copy
+/// @return void
+void copyBufferData(
+  const uint32_t source,
+  const uint32_t target,
+  const uint32_t sourceOffset,
+  const uint32_t targetOffset,
+  const uint32_t size
+);
+
+template <uint32_t GLBufferType, typename ValueType>
 class Buffer {
 public:
+  /// @brief The type of the buffer values
+  typedef ValueType Value;
+
   /// @brief Defines possible buffer usage methods
   enum Usage {
     Stream = GL_STREAM_DRAW,
@@ -16,16 +76,130 @@ public:
     Static = GL_STATIC_DRAW
   };
 
+  /// @brief Defines possible access intents for immutable storage
+  enum Access {
+    None = 0,
+    Read = GL_MAP_READ_BIT,
+    Write = GL_MAP_WRITE_BIT,
+    Persistent = GL_MAP_PERSISTENT_BIT,
+    Coherent = GL_MAP_COHERENT_BIT
+  };
+
   /// @brief Buffer constructor
-  /// @param array The buffer's data array
+  /// @param values The buffer's data values
+  /// @param usage The buffer's data usage method
   /// @return Buffer
-  Buffer(const std::vector<ValueType> array);
+  Buffer(const std::span<const ValueType> values, const Usage usage = Stream);
+
+  /// @brief Buffer constructor creating immutable storage
+  /// @param values The buffer's data values
+  /// @param usage The buffer's data usage method
+  /// @param access The buffer's combined access intents
+  /// @return Buffer
+  Buffer(
+    const std::span<const ValueType> values,
+    const Usage usage,
+    const uint32_t access
+  );
 
   /// @brief Buffer constructor
   /// @param array The buffer's data array
   /// @param usage The buffer's data usage method
   /// @return Buffer
-  Buffer(const std::vector<ValueType> array, const Usage usage);
+  Buffer(const std::vector<ValueType> &array, const Usage usage = Stream);
+
+  /// @brief Buffer constructor consuming a temporary array without copying it
+  /// @param array The buffer's data array
+  /// @param usage The buffer's data usage method
+  /// @return Buffer
+  Buffer(std::vector<ValueType> &&array, const Usage usage = Stream);
+
+  /// @brief Buffer constructor from borrowed memory
+  /// @param data A pointer to the buffer's first value
+  /// @param count The number of values
+  /// @param usage The buffer's data usage method
+  /// @return Buffer
+  template <std::same_as<ValueType> DataType>
+  Buffer(const DataType *data, const size_t count, const Usage usage = Stream);
+
+  /// @brief Buffer constructor from a contiguous iterator range
+  /// @param first The iterator to the buffer's first value
+  /// @param last The iterator past the buffer's last value
+  /// @param usage The buffer's data usage method
+  /// @return Buffer
+  template <std::contiguous_iterator Iterator>
+  Buffer(Iterator first, Iterator last, const Usage usage = Stream);
+
+  /// @brief Buffer constructor allocating uninitialized storage
+  /// @param count The number of values the buffer can hold
+  /// @param usage The buffer's data usage method
+  /// @return Buffer
+  Buffer(const uint32_t count, const Usage usage);
+
+  /// @brief Buffer constructor sub-allocating its storage from an arena
+  /// @param arena The arena holding the buffer' storage
+  /// @param values The buffer's data values
+  /// @param alignment The required byte offset alignment in the arena
+  /// @return Buffer
+  Buffer(
+    BufferArena &arena,
+    const std::span<const ValueType> values,
+    const uint32_t alignment = sizeof(ValueType)
+  );
+
+  /// @brief Buffer move constructor taking ownership of the gl buffer
+  /// @param other The buffer to move from
+  /// @return Buffer
+  Buffer(Buffer &&other) noexcept;
+
+  /// @brief Buffer move assignment taking ownership of the gl buffer
+  /// @param other The buffer to move from
+  /// @return A reference to this buffer
+  Buffer &operator=(Buffer &&other) noexcept;
+
+  /// @brief Buffers own their gl buffer & can not be copied
+  Buffer(const Buffer &) = delete;
+
+  /// @brief Buffers own their gl buffer & can not be copied
+  Buffer &operator=(const Buffer &) = delete;
+
+  /// @brief Buffer destructor releasing the gl buffer
+  ~Buffer();
+
+  /// @brief Replaces the buffer storage & values
+  /// @param values The new buffer values
+  /// @return void
+  void setData(const std::span<const ValueType> values);
+
+  /// @brief Records an update of a sub range of the buffer values
+  /// @param offset The index of the first value to update
+  /// @param values The new values
+  /// @return void
+  void update(const uint32_t offset, const std::span<const ValueType> values);
+
+  /// @brief Uploads the pending updates with as few calls as possible
+  /// @return void
+  void flush();
+
+  /// @brief Creates a standalone copy of the buffer on the gpu
+  /// Pending updates are carried over & sub-allocated storage is not shared
+  /// @return The new buffer
+  Buffer clone() const;
+
+  /// @brief Copies a byte range of the buffer into another one on the gpu
+  /// Pending updates of either buffer are not part of the copy
+  /// @param target The buffer to copy into, which may hold any value type
+  /// @param sourceOffset The byte offset of the range in this buffer
+  /// @param targetOffset The byte offset of the range in the target buffer
+  /// @param size The number of bytes to copy
+  /// @return void
+  template <uint32_t TargetBufferType, typename TargetValueType>
+  void copyTo(
+    Buffer<TargetBufferType, TargetValueType> &target,
+    const uint32_t sourceOffset,
+    const uint32_t targetOffset,
+    const uint32_t size
+  ) const;
 
   /// @brief Destroys the buffer instance
   /// @return voi
@@ -35,40 +209,119 @@ public:
   /// @return void
   void bind() const;
 
+  /// @brief Binds the whole buffer to an indexed binding point
+  /// @param index The binding point index
+  /// @return void
+  void bindBase(const uint32_t index) const
+    requires(isIndexedTarget(GLBufferType));
+
+  /// @brief Binds a byte range of the buffer to an indexed binding point
+  /// @param index The binding point index
+  /// @param offset The range byte offset, aligned as the gl target requires
+  /// @param size The range byte size
+  /// @return void
+  void bindRange(
+    const uint32_t index,
+    const uint32_t offset,
+    const uint32_t size
+  ) const
+    requires(isIndexedTarget(GLBufferType));
+
   /// @brief Returns the current buffer id
   /// @return The current buffer id
   const uint32_t getId() const;
 
-  /// @brief Returns the current buffer size
-  /// @return The current buffer size
+  /// @brief Returns the byte offset of the data in the gl buffer
+  /// @return The byte offset of the data in the gl buffer
+  const uint32_t getOffset() const;
+
+  /// @brief Returns the byte size of the buffer values
+  /// @return The byte size of the buffer values
   const uint32_t getSize() const;
 
+  /// @brief Returns the number of values in the buffer
+  /// @return The number of values in the buffer
+  const uint32_t getCount() const;
+
   /// @brief Returns the current buffer type
   /// @return The current buffer type
   const uint32_t getType() const;
 
+  /// @brief Returns whether the buffer storage can not be reallocated
+  /// @return Whether the buffer storage can not be reallocated
+  const bool isImmutable() const;
+
 private:
-  /// @brief The buffer' gl identifier
-  uint32_t _id;
+  /// @brief Buffer constructor leaving the storage to be created
+  /// @return Buffer
+  Buffer() = default;
+
+  /// @brief Creates the gl buffer & its storage
+  /// @param data The initial bytes or nullptr
+  /// @param usage The buffer's data usage method
+  /// @return void
+  void create(const void *data, const Usage usage);
+
+  /// @brief Creates the gl buffer & its immutable storage
+  /// @param data The initial bytes or nullptr
+  /// @param flags The gl storage flags
+  /// @return void
+  void createStorage(const void *data, const uint32_t flags);
+
+  /// @brief The buffer' gl identifier, zero when sub-allocated
+  uint32_t _id = 0;
 
   /// @brief The buffer size
-  uint32_t _size;
+  uint32_t _size = 0;
+
+  /// @brief The buffer's data usage method
+  Usage _usage = Stream;
+
+  /// @brief The immutable storage flags or zero for mutable storage
+  uint32_t _flags = 0;
+
+  /// @brief Whether the storage was created immutable
+  bool _immutable = false;
+
+  /// @brief Whether the storage is sub-allocated from an arena
+  bool _suballocated = false;
+
+  /// @brief The arena range holding the storage, patched when it moves &
+  /// cleared when the arena is destroyed
+  std::shared_ptr<const BufferArena::Allocation> _allocation;
 
   /// @brief The buffer' gl type
-  uint32_t _type = GLValueType;
+  static constexpr uint32_t _type = GLTypeTraits<ValueType>::type;
+
+  /// @brief The buffer' pending updates
+  DirtyRanges _updates;
 };
 
 #include "Buffer.inl"
 
 // declare default buffer types
-typedef Buffer<GL_ARRAY_BUFFER, GL_FLOAT, float> FloatBuffer;
-typedef Buffer<GL_ARRAY_BUFFER, GL_UNSIGNED_INT, uint32_t> Uint32Buffer;
-typedef Buffer<GL_ARRAY_BUFFER, GL_UNSIGNED_INT, uint16_t> Uint16Buffer;
-typedef Buffer<GL_ARRAY_BUFFER, GL_UNSIGNED_INT, uint8_t> Uint8Buffer;
-typedef Buffer<GL_ARRAY_BUFFER, GL_INT, int32_t> Int32Buffer;
-typedef Buffer<GL_ARRAY_BUFFER, GL_INT, int16_t> Int16Buffer;
-typedef Buffer<GL_ARRAY_BUFFER, GL_INT, int8_t> Int8Buffer;
-typedef Buffer<GL_ELEMENT_ARRAY_BUFFER, GL_UNSIGNED_INT, uint32_t> IndexBuffer;
+typedef Buffer<GL_ARRAY_BUFFER, float> FloatBuffer;
+typedef Buffer<GL_ARRAY_BUFFER, uint32_t> Uint32Buffer;
+typedef Buffer<GL_ARRAY_BUFFER, uint16_t> Uint16Buffer;
+typedef Buffer<GL_ARRAY_BUFFER, uint8_t> Uint8Buffer;
+typedef Buffer<GL_ARRAY_BUFFER, int32_t> Int32Buffer;
+typedef Buffer<GL_ARRAY_BUFFER, int16_t> Int16Buffer;
+typedef Buffer<GL_ARRAY_BUFFER, int8_t> Int8Buffer;
+typedef Buffer<GL_ARRAY_BUFFER, Half> HalfBuffer;
+typedef Buffer<GL_ARRAY_BUFFER, Snorm16> Snorm16Buffer;
+typedef Buffer<GL_ARRAY_BUFFER, Snorm8> Snorm8Buffer;
+typedef Buffer<GL_ARRAY_BUFFER, Unorm16> Unorm16Buffer;
+typedef Buffer<GL_ARRAY_BUFFER, Unorm8> Unorm8Buffer;
+typedef Buffer<GL_ARRAY_BUFFER, Int2101010> Int2101010Buffer;
+typedef Buffer<GL_ELEMENT_ARRAY_BUFFER, uint32_t> IndexBuffer;
+typedef Buffer<GL_ELEMENT_ARRAY_BUFFER, uint16_t> Index16Buffer;
+typedef Buffer<GL_ELEMENT_ARRAY_BUFFER, uint8_t> Index8Buffer;
+
+// declare indexed buffer types holding blocks of shader data
+template <typename BlockType>
+using UniformBuffer = Buffer<GL_UNIFORM_BUFFER, BlockType>;
+template <typename BlockType>
+using ShaderStorageBuffer = Buffer<GL_SHADER_STORAGE_BUFFER, BlockType>;
 
 // define posible buffer variations
 typedef std::variant<
@@ -79,7 +332,30 @@ typedef std::variant<
   Int32Buffer,
   Int16Buffer,
   Int8Buffer,
+  HalfBuffer,
+  Snorm16Buffer,
+  Snorm8Buffer,
+  Unorm16Buffer,
+  Unorm8Buffer,
+  Int2101010Buffer,
   IndexBuffer>
   BufferVariant;
 
-} // namespace stem
\ No newline at end of file
+// define posible index buffer widths
+typedef std::variant<IndexBuffer, Index16Buffer, Index8Buffer> IndexVariant;
+
+/// @brief Returns the narrowest gl index type able to hold an index
+/// @param maxIndex The largest index to store
+/// @return The gl index type
+const uint32_t selectIndexType(const uint32_t maxIndex);
+
+/// @brief Creates an index buffer using the narrowest possible index type
+/// @param indices The indices to store
+/// @param usage The buffer's data usage method
+/// @return The index buffer variant
+IndexVariant createIndexBuffer(
+  const std::span<const uint32_t> indices,
+  const uint32_t usage = GL_STATIC_DRAW
+);
+
+} // namespace stem
@@ -1,44 +1,373 @@
-template <uint32_t GLBufferType, uint32_t GLValueType, typename ValueType>
-Buffer<GLBufferType, GLValueType, ValueType>::Buffer(
-  const std::vector<ValueType> array
+template <uint32_t GLBufferType, typename ValueType>
+Buffer<GLBufferType, ValueType>::Buffer(
+  const std::span<const ValueType> values,
+  const Usage usage
+) :
+  _usage(usage) {
+  _size = values.size_bytes();
+  create(values.data(), usage);
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+Buffer<GLBufferType, ValueType>::Buffer(
+  const std::span<const ValueType> values,
+  const Usage usage,
+  const uint32_t access
+) :
+  _usage(usage), _immutable(true) {
+  _size = values.size_bytes();
+
+  // map the usage method onto storage update capabilities
+  uint32_t flags = access;
+  if (usage != Static) flags |= GL_DYNAMIC_STORAGE_BIT;
+  if (usage == Stream) flags |= GL_CLIENT_STORAGE_BIT;
+
+  createStorage(values.data(), flags);
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+Buffer<GLBufferType, ValueType>::Buffer(
+  const std::vector<ValueType> &array,
+  const Usage usage
+) :
+  Buffer(std::span<const ValueType>(array), usage){};
+
+template <uint32_t GLBufferType, typename ValueType>
+Buffer<GLBufferType, ValueType>::Buffer(
+  std::vector<ValueType> &&array,
+  const Usage usage
+) :
+  Buffer(std::span<const ValueType>(array), usage){};
+
+template <uint32_t GLBufferType, typename ValueType>
+template <std::same_as<ValueType> DataType>
+Buffer<GLBufferType, ValueType>::Buffer(
+  const DataType *data,
+  const size_t count,
+  const Usage usage
+) :
+  Buffer(std::span<const ValueType>(data, count), usage){};
+
+template <uint32_t GLBufferType, typename ValueType>
+template <std::contiguous_iterator Iterator>
+Buffer<GLBufferType, ValueType>::Buffer(
+  Iterator first,
+  Iterator last,
+  const Usage usage
 ) :
-  Buffer(array, Stream){};
+  Buffer(std::span<const ValueType>(first, last), usage){};
 
-template <uint32_t GLBufferType, uint32_t GLValueType, typename ValueType>
-Buffer<GLBufferType, GLValueType, ValueType>::Buffer(
-  const std::vector<ValueType> array,
+template <uint32_t GLBufferType, typename ValueType>
+Buffer<GLBufferType, ValueType>::Buffer(
+  const uint32_t count,
   const Usage usage
+) :
+  _usage(usage) {
+  _size = count * sizeof(ValueType);
+  create(nullptr, usage);
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+Buffer<GLBufferType, ValueType>::Buffer(
+  BufferArena &arena,
+  const std::span<const ValueType> values,
+  const uint32_t alignment
+) :
+  _immutable(true), _suballocated(true) {
+  _size = values.size_bytes();
+
+  // reserve a range in one of the arena' buffers, read back through the
+  // arena' record as defragmentation may move it
+  _allocation = arena.allocate(_size, alignment);
+  if (!_allocation) return;
+
+  arena.upload(*_allocation, values.data(), _size);
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+Buffer<GLBufferType, ValueType>::Buffer(Buffer &&other) noexcept {
+  *this = std::move(other);
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+Buffer<GLBufferType, ValueType> &
+Buffer<GLBufferType, ValueType>::operator=(Buffer &&other) noexcept {
+  if (this == &other) return *this;
+
+  // release our own storage before taking the other one
+  destroy();
+
+  _id = std::exchange(other._id, 0);
+  _size = std::exchange(other._size, 0);
+  _usage = other._usage;
+  _flags = other._flags;
+  _immutable = other._immutable;
+  _suballocated = std::exchange(other._suballocated, false);
+  _allocation = std::exchange(other._allocation, nullptr);
+  _updates = std::move(other._updates);
+  other._updates.clear();
+
+  return *this;
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+Buffer<GLBufferType, ValueType>::~Buffer() {
+  destroy();
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+void Buffer<GLBufferType, ValueType>::setData(
+  const std::span<const ValueType> values
 ) {
-  glAssert(glGenBuffers(1, &_id));
+  // immutable & sub-allocated storage can never be reallocated
+  if (_immutable) throw ImmutableBufferError(_id);
+
+  _size = values.size_bytes();
+  _updates.clear();
+
+  if (hasDirectStateAccess()) {
+    glAssert(glNamedBufferData(_id, _size, values.data(), _usage));
+    return;
+  }
+
   bind();
+  glAssert(glBufferData(GLBufferType, _size, values.data(), _usage));
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+void Buffer<GLBufferType, ValueType>::update(
+  const uint32_t offset,
+  const std::span<const ValueType> values
+) {
+  const uint32_t byteOffset = offset * sizeof(ValueType);
+  const uint32_t byteSize = values.size_bytes();
+
+  // reject updates outside of the buffer storage
+  if (byteOffset + byteSize > _size) {
+    throw BufferRangeError(byteOffset, byteSize, _size);
+  }
+
+  // reject updates of static immutable storage
+  if (_immutable && !_suballocated && !(_flags & GL_DYNAMIC_STORAGE_BIT)) {
+    throw ImmutableBufferError(_id);
+  }
+
+  _updates.write(byteOffset, values.data(), byteSize);
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+void Buffer<GLBufferType, ValueType>::flush() {
+  if (_updates.empty()) return;
 
-  _size = array.size() * sizeof(ValueType);
+  const bool dsa = hasDirectStateAccess();
+  if (!dsa) bind();
 
-  glAssert(glBufferData(GLBufferType, _size, &array[0], usage));
+  const uint32_t id = getId();
+  const uint32_t base = getOffset();
+
+  // upload every merged range
+  for (const auto &[offset, bytes] : _updates.getRanges()) {
+    if (dsa) {
+      glAssert(glNamedBufferSubData(
+        id, base + offset, bytes.size(), bytes.data()
+      ));
+    } else {
+      glAssert(glBufferSubData(
+        GLBufferType, base + offset, bytes.size(), bytes.data()
+      ));
+    }
+  }
+
+  _updates.clear();
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+Buffer<GLBufferType, ValueType> Buffer<GLBufferType, ValueType>::clone() const {
+  Buffer buffer;
+  buffer._size = _size;
+  buffer._usage = _usage;
+
+  // keep immutable storage flags, arena ranges become standalone buffers
+  if (_immutable && !_suballocated) {
+    buffer._immutable = true;
+    buffer.createStorage(nullptr, _flags);
+  } else {
+    buffer.create(nullptr, _usage);
+  }
+
+  copyTo(buffer, 0, 0, _size);
+  buffer._updates = _updates;
+
+  return buffer;
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+template <uint32_t TargetBufferType, typename TargetValueType>
+void Buffer<GLBufferType, ValueType>::copyTo(
+  Buffer<TargetBufferType, TargetValueType> &target,
+  const uint32_t sourceOffset,
+  const uint32_t targetOffset,
+  const uint32_t size
+) const {
+  // reject copies outside of either buffer storage
+  if (sourceOffset + size > _size) {
+    throw BufferRangeError(sourceOffset, size, _size);
+  }
+
+  if (targetOffset + size > target.getSize()) {
+    throw BufferRangeError(targetOffset, size, target.getSize());
+  }
+
+  if (!size) return;
+
+  copyBufferData(
+    getId(),
+    target.getId(),
+    getOffset() + sourceOffset,
+    target.getOffset() + targetOffset,
+    size
+  );
 }
 
-template <uint32_t GLBufferType, uint32_t GLValueType, typename ValueType>
-void Buffer<GLBufferType, GLValueType, ValueType>::destroy() {
-  glAssert(glDeleteBuffers(1, &_id));
+template <uint32_t GLBufferType, typename ValueType>
+void Buffer<GLBufferType, ValueType>::destroy() {
+  // give sub-allocated storage back to its arena at its current offset,
+  // unless the arena was destroyed first & already released it
+  if (_suballocated) {
+    if (_allocation && _allocation->arena) {
+      _allocation->arena->free(_allocation.get());
+    }
+
+    _suballocated = false;
+    _allocation = nullptr;
+    return;
+  }
+
+  if (!_id) return;
+
+  // defer the deletion until the gpu is done with in flight frames
+  if (DeletionQueue *queue = DeletionQueue::getCurrent()) {
+    queue->deleteBuffer(_id);
+  } else {
+    glAssert(glDeleteBuffers(1, &_id));
+  }
+
   _id = 0;
 }
 
-template <uint32_t GLBufferType, uint32_t GLValueType, typename ValueType>
-void Buffer<GLBufferType, GLValueType, ValueType>::bind() const {
-  glAssert(glBindBuffer(GLBufferType, _id));
+template <uint32_t GLBufferType, typename ValueType>
+void Buffer<GLBufferType, ValueType>::create(
+  const void *data,
+  const Usage usage
+) {
+  // recycle a released buffer of the same size class when possible
+  if (DeletionQueue *queue = DeletionQueue::getCurrent()) {
+    _id = queue->createBuffer(_size, usage);
+    if (!data) return;
+
+    if (hasDirectStateAccess()) {
+      glAssert(glNamedBufferSubData(_id, 0, _size, data));
+      return;
+    }
+
+    bind();
+    glAssert(glBufferSubData(GLBufferType, 0, _size, data));
+    return;
+  }
+
+  // create the storage without touching the bindings when possible
+  if (hasDirectStateAccess()) {
+    glAssert(glCreateBuffers(1, &_id));
+    glAssert(glNamedBufferData(_id, _size, data, usage));
+    return;
+  }
+
+  glAssert(glGenBuffers(1, &_id));
+  bind();
+
+  glAssert(glBufferData(GLBufferType, _size, data, usage));
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+void Buffer<GLBufferType, ValueType>::createStorage(
+  const void *data,
+  const uint32_t flags
+) {
+  // keep the flags for later update checks
+  _flags = flags;
+
+  if (hasDirectStateAccess()) {
+    glAssert(glCreateBuffers(1, &_id));
+    glAssert(glNamedBufferStorage(_id, _size, data, flags));
+    return;
+  }
+
+  glAssert(glGenBuffers(1, &_id));
+  bind();
+
+  glAssert(glBufferStorage(GLBufferType, _size, data, flags));
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+void Buffer<GLBufferType, ValueType>::bind() const {
+  glAssert(glBindBuffer(GLBufferType, getId()));
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+void Buffer<GLBufferType, ValueType>::bindBase(const uint32_t index) const
+  requires(isIndexedTarget(GLBufferType))
+{
+  // sub-allocated storage only owns a range of the gl buffer
+  if (getOffset()) {
+    bindRange(index, 0, _size);
+    return;
+  }
+
+  glAssert(glBindBufferBase(GLBufferType, index, getId()));
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+void Buffer<GLBufferType, ValueType>::bindRange(
+  const uint32_t index,
+  const uint32_t offset,
+  const uint32_t size
+) const
+  requires(isIndexedTarget(GLBufferType))
+{
+  // reject ranges outside of the buffer storage
+  if (offset + size > _size) throw BufferRangeError(offset, size, _size);
+
+  glAssert(glBindBufferRange(
+    GLBufferType, index, getId(), getOffset() + offset, size
+  ));
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+const uint32_t Buffer<GLBufferType, ValueType>::getId() const {
+  return _allocation ? _allocation->buffer : _id;
 }
 
-template <uint32_t GLBufferType, uint32_t GLValueType, typename ValueType>
-const uint32_t Buffer<GLBufferType, GLValueType, ValueType>::getId() const {
-  return _id;
+template <uint32_t GLBufferType, typename ValueType>
+const uint32_t Buffer<GLBufferType, ValueType>::getOffset() const {
+  return _allocation ? _allocation->offset : 0;
 }
 
-template <uint32_t GLBufferType, uint32_t GLValueType, typename ValueType>
-const uint32_t Buffer<GLBufferType, GLValueType, ValueType>::getSize() const {
+template <uint32_t GLBufferType, typename ValueType>
+const uint32_t Buffer<GLBufferType, ValueType>::getSize() const {
   return _size;
 }
 
-template <uint32_t GLBufferType, uint32_t GLValueType, typename ValueType>
-const uint32_t Buffer<GLBufferType, GLValueType, ValueType>::getType() const {
+template <uint32_t GLBufferType, typename ValueType>
+const uint32_t Buffer<GLBufferType, ValueType>::getCount() const {
+  return _size / sizeof(ValueType);
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+const uint32_t Buffer<GLBufferType, ValueType>::getType() const {
   return _type;
-}
\ No newline at end of file
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+const bool Buffer<GLBufferType, ValueType>::isImmutable() const {
+  return _immutable;
+}
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+#include <functional>
+#include <glad/gl.h>
+#include <stem/FreeList.hpp>
+
+namespace stem {
+
+class BufferArena {
+public:
+  /// @brief Defines a range sub-allocated from one of the arena' buffers
+  struct Allocation {
+    /// @brief The gl identifier of the buffer holding the range
+    uint32_t buffer = 0;
+
+    /// @brief The range byte offset in the buffer
+    uint32_t offset = 0;
+
+    /// @brief The range byte size
+    uint32_t size = 0;
+
+    /// @brief The arena page index holding the range
+    uint32_t page = 0;
+
+    /// @brief The arena holding the range, null once the arena is destroyed
+    BufferArena *arena = nullptr;
+  };
+
+  /// @brief Defines a hook notified when defragmentation moves a range
+  typedef std::function<void(const Allocation &from, const Allocation &to)>
+    Relocation;
+
+  /// @brief BufferArena constructor
+  /// @param pageSize The byte size of every gl buffer created by the arena
+  /// @param usage The gl usage hint of the arena' buffers
+  /// @return BufferArena
+  BufferArena(
+    const uint32_t pageSize = 64 * 1024 * 1024,
+    const uint32_t usage = GL_STATIC_DRAW
+  );
+
+  /// @brief Arenas are referenced by their buffers & can not be copied
+  BufferArena(const BufferArena &) = delete;
+
+  /// @brief Arenas are referenced by their buffers & can not be copied
+  BufferArena &operator=(const BufferArena &) = delete;
+
+  /// @brief BufferArena destructor releasing every page buffer
+  ~BufferArena();
+
+  /// @brief Reserves a range, creating a new page when none has room
+  /// The range record is shared with the arena, patched in place whenever
+  /// defragmentation moves it & cleared when the arena is destroyed
+  /// @param size The byte size of the range
+  /// @param alignment The required byte offset alignment
+  /// @return The reserved range or nullptr for empty ranges
+  std::shared_ptr<const Allocation> allocate(
+    const uint32_t size,
+    const uint32_t alignment = 4
+  );
+
+  /// @brief Releases a range back to its page, invalidating it
+  /// @param allocation The range to release
+  /// @return void
+  void free(const Allocation *allocation);
+
+  /// @brief Uploads data into a reserved range
+  /// @param allocation The destination range
+  /// @param data The bytes to upload
+  /// @param size The number of bytes to upload
+  /// @param offset The byte offset inside the range
+  /// @return void
+  void upload(
+    const Allocation &allocation,
+    const void *data,
+    const uint32_t size,
+    const uint32_t offset = 0
+  );
+
+  /// @brief Compacts fragmented pages into fresh buffers on the gpu
+  /// Live ranges are patched in place & the arena generation is bumped so
+  /// vertex arrays rebind their buffers, data derived from range offsets
+  /// such as indirect commands must be rebuilt through the hook
+  /// @param relocation The hook notified for every moved range
+  /// @return void
+  void defragment(const Relocation &relocation = nullptr);
+
+  /// @brief Destroys every page buffer, clearing the records of live ranges
+  /// so their owners read a null buffer instead of a deleted one
+  /// @return void
+  void destroy();
+
+  /// @brief Returns the number of pages
+  /// @return The number of pages
+  const uint32_t getPageCount() const;
+
+  /// @brief Returns the number of reserved bytes across pages
+  /// @return The number of reserved bytes across pages
+  const uint32_t getUsedSize() const;
+
+  /// @brief Returns a counter bumped whenever any arena moves live ranges
+  /// @return The arenas generation
+  static const uint64_t getGeneration();
+
+private:
+  /// @brief Stores the alignment & owned record of a live range
+  struct Block {
+    /// @brief The range required alignment
+    uint32_t alignment;
+
+    /// @brief The range record shared with its owner
+    std::shared_ptr<Allocation> allocation;
+  };
+
+  /// @brief Stores a single gl buffer & its sub-allocation state
+  struct Page {
+    /// @brief The page' gl identifier
+    uint32_t id;
+
+    /// @brief The page' free blocks
+    FreeList blocks;
+
+    /// @brief The page' live ranges keyed by offset
+    std::map<uint32_t, Block> live;
+  };
+
+  /// @brief Creates a gl buffer of a given byte size
+  /// @param size The byte size of the buffer
+  /// @return The buffer' gl identifier
+  uint32_t createBuffer(const uint32_t size) const;
+
+  /// @brief Returns whether live ranges are packed from the page start
+  /// @param page The page to check
+  /// @return Whether the page is compact
+  static bool isCompact(const Page &page);
+
+  /// @brief The default byte size of a page
+  uint32_t _pageSize;
+
+  /// @brief The gl usage hint of the pages
+  uint32_t _usage;
+
+  /// @brief The arena' pages
+  std::vector<Page> _pages;
+
+  /// @brief The counter bumped whenever any arena moves live ranges
+  static uint64_t _generation;
+};
+
+} // namespace stem
@@ -0,0 +1,9 @@
+#pragma once
+
+namespace stem {
+
+/// @brief Returns whether the current context supports direct state access
+/// @return Whether objects can be edited without binding them
+const bool hasDirectStateAccess();
+
+} // namespace stem
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <span>
+#include <string>
+
+#include <stem/Buffer.hpp>
+#include <stem/Program.hpp>
+#include <stem/Geometry.hpp>
+#include <stem/MeshletBuilder.hpp>
+
+namespace stem {
+
+class ClusterCuller {
+public:
+  /// @brief Defines the camera meshlets are culled against, in the space of
+  /// the geometry positions
+  struct View {
+    /// @brief The frustum planes as xyz normals facing inside & w distances
+    float planes[6][4] = {};
+
+    /// @brief The camera position, w unused
+    float camera[4] = {};
+  };
+
+  /// @brief ClusterCuller constructor uploading meshlets & compiling the pass
+  /// Requires gl 4.3 to cull & gl 4.6 to draw
+  /// @param meshlets The meshlets of the geometry index buffer
+  /// @return ClusterCuller
+  ClusterCuller(const std::span<const Meshlet> meshlets);
+
+  /// @brief Writes a draw command for every visible meshlet on the gpu
+  /// @param geometry The geometry whose draw range holds the meshlet indices
+  /// @param view The camera to cull against
+  /// @return void
+  void cull(const Geometry &geometry, const View &view);
+
+  /// @brief Draws the meshlets that survived the latest cull
+  /// @param geometry The geometry the meshlets were culled for
+  /// @param program The program to use to draw the meshlets
+  /// @return void
+  void draw(Geometry &geometry, const Program &program);
+
+  /// @brief Returns the command buffer' gl identifier
+  /// @return The command buffer' gl identifier
+  const uint32_t getCommandsId() const;
+
+  /// @brief Returns the gl identifier of the buffer holding the draw count
+  /// @return The gl identifier of the buffer holding the draw count
+  const uint32_t getCountId() const;
+
+  /// @brief Returns the number of meshlets culled by every pass
+  /// @return The number of meshlets
+  const uint32_t getCount() const;
+
+private:
+  /// @brief Stores the pass parameters, laid out as an std140 block
+  struct Parameters {
+    /// @brief The camera to cull against
+    View view;
+
+    /// @brief The first index of the geometry draw range
+    uint32_t firstIndex = 0;
+
+    /// @brief The value added to every index before fetching vertices
+    int32_t baseVertex = 0;
+
+    /// @brief The number of meshlets
+    uint32_t count = 0;
+
+    /// @brief Pads the block to a vec4 boundary
+    uint32_t padding = 0;
+  };
+
+  /// @brief The number of meshlets culled by a single work group
+  static constexpr uint32_t GROUP_SIZE = 64;
+
+  /// @brief The culling compute shader source
+  static const std::string SOURCE;
+
+  /// @brief The culling compute program
+  Program _program;
+
+  /// @brief The meshlets read by the pass
+  ShaderStorageBuffer<Meshlet> _meshlets;
+
+  /// @brief The draw commands written by the pass
+  ShaderStorageBuffer<DrawCommand> _commands;
+
+  /// @brief The number of draw commands written by the pass
+  ShaderStorageBuffer<uint32_t> _count;
+
+  /// @brief The pass parameters
+  UniformBuffer<Parameters> _parameters;
+};
+
+} // namespace stem
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <map>
+#include <deque>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <glad/gl.h>
+
+namespace stem {
+
+class DeletionQueue {
+public:
+  /// @brief DeletionQueue constructor
+  /// @param poolSize The byte size of released buffers kept for recycling
+  /// @return DeletionQueue
+  DeletionQueue(const uint32_t poolSize = 64 * 1024 * 1024);
+
+  /// @brief DeletionQueue move constructor taking ownership of the objects
+  /// @param other The queue to move from
+  /// @return DeletionQueue
+  DeletionQueue(DeletionQueue &&other) noexcept;
+
+  /// @brief DeletionQueue move assignment taking ownership of the objects
+  /// @param other The queue to move from
+  /// @return A reference to this queue
+  DeletionQueue &operator=(DeletionQueue &&other) noexcept;
+
+  /// @brief Deletion queues own their objects & can not be copied
+  DeletionQueue(const DeletionQueue &) = delete;
+
+  /// @brief Deletion queues own their objects & can not be copied
+  DeletionQueue &operator=(const DeletionQueue &) = delete;
+
+  /// @brief DeletionQueue destructor releasing every object
+  ~DeletionQueue();
+
+  /// @brief Makes the queue receive the objects destroyed from now on
+  /// @return void
+  void makeCurrent();
+
+  /// @brief Returns the queue receiving destroyed objects, if any
+  /// @return The current queue or null
+  static DeletionQueue *getCurrent();
+
+  /// @brief Creates a mutable buffer with storage of an exact byte size
+  /// Recycles a released buffer of the same size class & usage when possible,
+  /// whose storage may then be up to a size class larger
+  /// @param size The minimum byte size of the storage
+  /// @param usage The gl usage hint of the storage
+  /// @return The buffer' gl identifier
+  uint32_t createBuffer(const uint32_t size, const uint32_t usage);
+
+  /// @brief Defers the deletion of a buffer until the gpu is done with it
+  /// @param id The buffer' gl identifier
+  /// @return void
+  void deleteBuffer(const uint32_t id);
+
+  /// @brief Defers the deletion of a program until the gpu is done with it
+  /// @param id The program' gl identifier
+  /// @return void
+  void deleteProgram(const uint32_t id);
+
+  /// @brief Defers the deletion of a vertex array until the gpu is done with it
+  /// @param id The vertex array' gl identifier
+  /// @return void
+  void deleteVertexArray(const uint32_t id);
+
+  /// @brief Fences the objects destroyed this frame & releases the objects of
+  /// frames the gpu has completed, call once per frame after drawing
+  /// Throws when a fence wait fails
+  /// @return void
+  void update();
+
+  /// @brief Blocks until every destroyed object is released
+  /// Throws when a fence wait fails
+  /// @return void
+  void finish();
+
+  /// @brief Returns the byte size of released buffers kept for recycling
+  /// @return The byte size of released buffers kept for recycling
+  const uint64_t getPoolSize() const;
+
+  /// @brief Releases every object & recycled buffer without waiting for the
+  /// gpu, which keeps objects in use alive until it is done with them
+  /// @return void
+  void destroy();
+
+  /// @brief Returns the size class of a buffer byte size, classes step by a
+  /// quarter of the power of two below them from 256 bytes on
+  /// @param size The byte size
+  /// @return The smallest size class holding the size
+  static const uint32_t getSizeClass(const uint32_t size);
+
+private:
+  /// @brief Defines the kinds of deferred objects
+  enum Kind { BufferObject, ProgramObject, VertexArrayObject };
+
+  /// @brief Stores an object waiting for its frame fence
+  struct Object {
+    /// @brief The object' kind
+    Kind kind;
+
+    /// @brief The object' gl identifier
+    uint32_t id;
+  };
+
+  /// @brief Stores the objects destroyed during a frame
+  struct Frame {
+    /// @brief The fence signaled when the frame completed
+    GLsync fence;
+
+    /// @brief The destroyed objects
+    std::vector<Object> objects;
+  };
+
+  /// @brief Stores a recycled buffer & its storage byte size
+  struct Pooled {
+    /// @brief The buffer' gl identifier
+    uint32_t id;
+
+    /// @brief The storage byte size, at least the buffer' size class
+    uint32_t size;
+  };
+
+  /// @brief Defines recycled buffers keyed by size class & usage
+  typedef std::map<std::pair<uint32_t, uint32_t>, std::vector<Pooled>> Pool;
+
+  /// @brief Returns the largest size class a byte size holds
+  /// @param size The byte size
+  /// @return The size class or zero below the smallest class
+  static uint32_t getPoolClass(const uint32_t size);
+
+  /// @brief Releases the objects of completed frames
+  /// Throws when a wait fails, the gpu may still use the frame' objects
+  /// @param wait Whether to block until every frame completed
+  /// @return void
+  void retire(const bool wait);
+
+  /// @brief Recycles or deletes an object the gpu is done with
+  /// @param object The object to release
+  /// @return void
+  void release(const Object &object);
+
+  /// @brief Deletes an object without recycling it
+  /// @param object The object to delete
+  /// @return void
+  void discard(const Object &object);
+
+  /// @brief The queue receiving destroyed objects
+  static DeletionQueue *_current;
+
+  /// @brief The maximum byte size of recycled buffers
+  uint32_t _poolSize = 0;
+
+  /// @brief The byte size of recycled buffers
+  uint64_t _pooled = 0;
+
+  /// @brief The objects destroyed since the last update
+  std::vector<Object> _objects;
+
+  /// @brief The fenced frames in flight
+  std::deque<Frame> _frames;
+
+  /// @brief The recycled buffers
+  Pool _pool;
+};
+
+} // namespace stem
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <map>
+#include <vector>
+#include <cstdint>
+
+namespace stem {
+
+class DirtyRanges {
+public:
+  /// @brief Defines the pending bytes of ranges keyed by their byte offset
+  typedef std::map<uint32_t, std::vector<uint8_t>> Ranges;
+
+  /// @brief Records a write, merging it with overlapping & adjacent ranges
+  /// @param offset The byte offset of the write
+  /// @param data The written bytes
+  /// @param size The number of written bytes
+  /// @return void
+  void write(const uint32_t offset, const void *data, const uint32_t size);
+
+  /// @brief Returns the pending merged ranges
+  /// @return The pending merged ranges
+  const Ranges &getRanges() const;
+
+  /// @brief Returns whether there are no pending ranges
+  /// @return Whether there are no pending ranges
+  const bool empty() const;
+
+  /// @brief Discards all pending ranges
+  /// @return void
+  void clear();
+
+private:
+  /// @brief The pending merged ranges
+  Ranges _ranges;
+};
+
+} // namespace stem
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <stem/Geometry.hpp>
+#include <stem/GrowableBuffer.hpp>
+
+namespace stem {
+
+class DrawBatch {
+public:
+  /// @brief DrawBatch constructor
+  /// @param capacity The number of commands the batch can initially hold
+  /// @return DrawBatch
+  DrawBatch(const uint32_t capacity = 1024);
+
+  /// @brief Records a draw of a geometry sharing the batch' buffers & layouts
+  /// The first accepted geometry of the batch provides the vertex arrays &
+  /// must outlive the submission, geometries without indices are rejected
+  /// @param geometry The geometry to draw
+  /// @param instances The number of instances to draw
+  /// @param baseInstance The first instance read by per-instance attributes
+  /// @return Whether the geometry could join the batch
+  const bool add(
+    Geometry &geometry,
+    const uint32_t instances = 1,
+    const uint32_t baseInstance = 0
+  );
+
+  /// @brief Draws every recorded command with a single call
+  /// @param program The program to use to draw the commands
+  /// @return void
+  void submit(const Program &program);
+
+  /// @brief Draws the recorded commands with a count read from a gpu buffer
+  /// Requires gl 4.6
+  /// @param program The program to use to draw the commands
+  /// @param parameter The gl identifier of the buffer holding the count
+  /// @param parameterOffset The byte offset of the count
+  /// @return void
+  void submitCount(
+    const Program &program,
+    const uint32_t parameter,
+    const uint32_t parameterOffset = 0
+  );
+
+  /// @brief Discards every recorded command while keeping the storage
+  /// @return void
+  void clear();
+
+  /// @brief Returns the number of recorded commands
+  /// @return The number of recorded commands
+  const uint32_t getCount() const;
+
+  /// @brief Returns the command buffer' gl identifier, which the gpu may fill
+  /// @return The command buffer' gl identifier
+  const uint32_t getId() const;
+
+private:
+  /// @brief The geometry whose vertex arrays draw the batch
+  Geometry *_base = nullptr;
+
+  /// @brief The recorded commands
+  GrowableBuffer<GL_DRAW_INDIRECT_BUFFER, DrawCommand> _commands;
+};
+
+} // namespace stem
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <map>
+#include <cstdint>
+#include <optional>
+
+namespace stem {
+
+class FreeList {
+public:
+  /// @brief FreeList constructor
+  /// @param capacity The number of bytes managed by the free list
+  /// @return FreeList
+  FreeList(const uint32_t capacity);
+
+  /// @brief Reserves the smallest free block able to hold an aligned range
+  /// @param size The number of bytes to reserve
+  /// @param alignment The required offset alignment
+  /// @return The reserved offset if a block was large enough
+  std::optional<uint32_t>
+  allocate(const uint32_t size, const uint32_t alignment = 1);
+
+  /// @brief Releases a range & merges it with its free neighbours
+  /// @param offset The released range offset
+  /// @param size The released range size
+  /// @return void
+  void free(const uint32_t offset, const uint32_t size);
+
+  /// @brief Returns the number of bytes managed by the free list
+  /// @return The number of bytes managed by the free list
+  const uint32_t getCapacity() const;
+
+  /// @brief Returns the number of free bytes
+  /// @return The number of free bytes
+  const uint32_t getFreeSize() const;
+
+  /// @brief Returns the size of the largest free block
+  /// @return The size of the largest free block
+  const uint32_t getLargestBlock() const;
+
+  /// @brief Returns the number of free blocks
+  /// @return The number of free blocks
+  const uint32_t getBlockCount() const;
+
+private:
+  /// @brief Inserts a free block in both lookups
+  /// @param offset The block offset
+  /// @param size The block size
+  /// @return void
+  void insert(const uint32_t offset, const uint32_t size);
+
+  /// @brief Removes a free block from both lookups
+  /// @param offset The block offset
+  /// @param size The block size
+  /// @return void
+  void erase(const uint32_t offset, const uint32_t size);
+
+  /// @brief The number of bytes managed by the free list
+  uint32_t _capacity;
+
+  /// @brief The number of free bytes
+  uint32_t _free;
+
+  /// @brief The free blocks sizes keyed by offset
+  std::map<uint32_t, uint32_t> _offsets;
+
+  /// @brief The free blocks offsets keyed by size for best fit lookups
+  std::multimap<uint32_t, uint32_t> _sizes;
+};
+
+} // namespace stem
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <cstdint>
+
+#include <stem/Bounds.hpp>
+#include <stem/Exception.hpp>
+
+namespace stem {
+
+class CullMaskError : public Exception {
+public:
+  /// @brief CullMaskError' class constructor
+  /// @param size The faulty mask' byte size
+  /// @param expected The byte size needed by the boxes
+  /// @return CullMaskError
+  CullMaskError(const uint32_t size, const uint32_t expected);
+};
+
+/// @brief Stores the boxes of a draw list as structure of arrays
+struct BoundsList {
+  /// @brief The smallest x coordinate of every box
+  std::vector<float> minX;
+
+  /// @brief The smallest y coordinate of every box
+  std::vector<float> minY;
+
+  /// @brief The smallest z coordinate of every box
+  std::vector<float> minZ;
+
+  /// @brief The largest x coordinate of every box
+  std::vector<float> maxX;
+
+  /// @brief The largest y coordinate of every box
+  std::vector<float> maxY;
+
+  /// @brief The largest z coordinate of every box
+  std::vector<float> maxZ;
+
+  /// @brief Appends the box of a bounds to the list
+  /// @param bounds The bounds to append
+  /// @return void
+  void push(const Bounds &bounds);
+
+  /// @brief Removes every box while keeping the storage
+  /// @return void
+  void clear();
+
+  /// @brief Returns the number of boxes
+  /// @return The number of boxes
+  const uint32_t getCount() const;
+};
+
+class Frustum {
+public:
+  /// @brief Frustum constructor extracting the planes of a camera
+  /// @param matrix The column-major view projection matrix
+  /// @return Frustum
+  Frustum(const std::span<const float, 16> matrix);
+
+  /// @brief Returns whether a box is at least partially inside the frustum
+  /// @param bounds The bounds whose box is tested
+  /// @return Whether the box is visible
+  const bool intersects(const Bounds &bounds) const;
+
+  /// @brief Tests every box of a draw list against the frustum, 8 at a time
+  /// Box i is visible when bit i % 8 of byte i / 8 of the mask is set
+  /// @param bounds The boxes to test
+  /// @param mask The visibility bits, at least (count + 7) / 8 bytes or throws
+  /// @return void
+  void cull(const BoundsList &bounds, const std::span<uint8_t> mask) const;
+
+  /// @brief Returns the planes as xyz normals facing inside & w distances
+  /// @return The left, right, bottom, top, near & far planes
+  const std::span<const float, 24> getPlanes() const;
+
+private:
+  /// @brief The normalized planes, facing inside
+  float _planes[6][4];
+};
+
+} // namespace stem
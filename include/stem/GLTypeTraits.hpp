@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <glad/gl.h>
+
+namespace stem {
+
+/// @brief A 16-bit IEEE half precision float
+struct Half {
+  /// @brief The raw half precision bits
+  uint16_t bits;
+};
+
+/// @brief A signed 8-bit value normalized to [-1, 1]
+struct Snorm8 {
+  /// @brief The raw fixed-point value
+  int8_t value;
+};
+
+/// @brief A signed 16-bit value normalized to [-1, 1]
+struct Snorm16 {
+  /// @brief The raw fixed-point value
+  int16_t value;
+};
+
+/// @brief An unsigned 8-bit value normalized to [0, 1]
+struct Unorm8 {
+  /// @brief The raw fixed-point value
+  uint8_t value;
+};
+
+/// @brief An unsigned 16-bit value normalized to [0, 1]
+struct Unorm16 {
+  /// @brief The raw fixed-point value
+  uint16_t value;
+};
+
+/// @brief Four signed normalized components packed as 10, 10, 10 & 2 bits
+struct Int2101010 {
+  /// @brief The raw packed bits, x in the lowest bits
+  uint32_t bits;
+};
+
+/// @brief Describes how a gl data type is read by vertex attributes
+template <uint32_t GLType, bool Normalized = false, bool Packed = false>
+struct GLTypeInfo {
+  /// @brief The gl data type
+  static constexpr uint32_t type = GLType;
+
+  /// @brief Whether fixed-point values are always normalized
+  static constexpr bool normalized = Normalized;
+
+  /// @brief Whether a single value holds every component of an attribute
+  static constexpr bool packed = Packed;
+};
+
+/// @brief Maps a value type onto its gl data type enum
+/// Types without a gl equivalent map onto GL_NONE
+template <typename ValueType>
+struct GLTypeTraits : GLTypeInfo<GL_NONE> {};
+
+template <>
+struct GLTypeTraits<float> : GLTypeInfo<GL_FLOAT> {};
+
+template <>
+struct GLTypeTraits<double> : GLTypeInfo<GL_DOUBLE> {};
+
+template <>
+struct GLTypeTraits<uint32_t> : GLTypeInfo<GL_UNSIGNED_INT> {};
+
+template <>
+struct GLTypeTraits<uint16_t> : GLTypeInfo<GL_UNSIGNED_SHORT> {};
+
+template <>
+struct GLTypeTraits<uint8_t> : GLTypeInfo<GL_UNSIGNED_BYTE> {};
+
+template <>
+struct GLTypeTraits<int32_t> : GLTypeInfo<GL_INT> {};
+
+template <>
+struct GLTypeTraits<int16_t> : GLTypeInfo<GL_SHORT> {};
+
+template <>
+struct GLTypeTraits<int8_t> : GLTypeInfo<GL_BYTE> {};
+
+template <>
+struct GLTypeTraits<Half> : GLTypeInfo<GL_HALF_FLOAT> {};
+
+template <>
+struct GLTypeTraits<Snorm8> : GLTypeInfo<GL_BYTE, true> {};
+
+template <>
+struct GLTypeTraits<Snorm16> : GLTypeInfo<GL_SHORT, true> {};
+
+template <>
+struct GLTypeTraits<Unorm8> : GLTypeInfo<GL_UNSIGNED_BYTE, true> {};
+
+template <>
+struct GLTypeTraits<Unorm16> : GLTypeInfo<GL_UNSIGNED_SHORT, true> {};
+
+template <>
+struct GLTypeTraits<Int2101010> :
+  GLTypeInfo<GL_INT_2_10_10_10_REV, true, true> {};
+
+} // namespace stem
@@ -2,13 +2,42 @@
 
 #include <string>
 #include <vector>
+#include <optional>
 #include <unordered_map>
 
+#include <stem/Bounds.hpp>
 #include <stem/Buffer.hpp>
+#include <stem/Exception.hpp>
 #include <stem/Program.hpp>
+#include <stem/VertexLayout.hpp>
 
 namespace stem {
 
+class IndirectDrawError : public Exception {
+public:
+  /// @brief IndirectDrawError' class constructor
+  /// @return IndirectDrawError
+  IndirectDrawError();
+};
+
+/// @brief Defines an indexed indirect draw, laid out as gl reads it
+struct DrawCommand {
+  /// @brief The number of indices
+  uint32_t count = 0;
+
+  /// @brief The number of instances
+  uint32_t instanceCount = 1;
+
+  /// @brief The first index in the element buffer
+  uint32_t firstIndex = 0;
+
+  /// @brief The value added to every index before fetching vertices
+  int32_t baseVertex = 0;
+
+  /// @brief The first instance read by per-instance attributes
+  uint32_t baseInstance = 0;
+};
+
 class Geometry {
 public:
   /// @brief Defines a simple geometry attribute
@@ -28,32 +57,118 @@ public:
     /// @brief The first attribute' offset
     signed long int offset = 0;
 
+    /// @brief The number of instances sharing a value, zero per vertex
+    uint32_t divisor = 0;
+
     /// @brief The attribute' buffer variant
     BufferVariant buffer;
   };
 
-  /// @brief The geometry draw range start & count without index buffer
+  /// @brief Defines attributes sharing a single interleaved buffer
+  struct Interleaved {
+    /// @brief The layout of a single vertex in the buffer
+    VertexLayout layout;
+
+    /// @brief The interleaved vertex bytes
+    Uint8Buffer buffer;
+
+    /// @brief The number of instances sharing a vertex, zero per vertex
+    uint32_t divisor = 0;
+  };
+
+  /// @brief Defines per-instance attributes read from a buffer owned elsewhere
+  struct Instances {
+    /// @brief The layout of a single instance, its stride matching the buffer
+    VertexLayout layout;
+
+    /// @brief The gl identifier of the buffer, read from its first byte
+    uint32_t buffer = 0;
+
+    /// @brief The number of instances sharing a value
+    uint32_t divisor = 1;
+  };
+
+  /// @brief The geometry draw range, in vertices without index buffer or in
+  /// indices with an index buffer
   struct Range {
-    /// @brief The draw range start index
-    uint16_t start = 0;
+    /// @brief The first vertex, or the first index with an index buffer
+    uint32_t start = 0;
+
+    /// @brief The number of vertices, or of indices with an index buffer
+    uint32_t count = 0;
 
-    /// @brief The draw range count
-    uint16_t count = 0;
+    /// @brief The value added to every index before fetching vertices
+    int32_t baseVertex = 0;
   };
 
   /// @brief Geometry constructor
+  /// @param attributes The attributes to move into the geometry
   /// @return Geometry
-  Geometry(const std::vector<Attribute> attributes);
+  Geometry(std::vector<Attribute> attributes = {});
+
+  /// @brief Geometry move constructor taking ownership of the gl objects
+  /// @param other The geometry to move from
+  /// @return Geometry
+  Geometry(Geometry &&other) noexcept;
+
+  /// @brief Geometry move assignment taking ownership of the gl objects
+  /// @param other The geometry to move from
+  /// @return A reference to this geometry
+  Geometry &operator=(Geometry &&other) noexcept;
+
+  /// @brief Geometries own their gl objects & can not be copied
+  Geometry(const Geometry &) = delete;
+
+  /// @brief Geometries own their gl objects & can not be copied
+  Geometry &operator=(const Geometry &) = delete;
+
+  /// @brief Geometry destructor releasing the gl objects
+  ~Geometry();
 
   /// @brief Sets the index buffer attribute for the geometry
-  /// @param buffer The index buffer to assign to the geometry
+  /// The draw range is reset to every index of the buffer
+  /// @param buffer The index buffer of any width to assign to the geometry
   /// @return void
-  void setIndex(const IndexBuffer buffer);
+  void setIndex(IndexVariant buffer);
 
   /// @brief Sets a specific buffer attribute for the geometry
   /// @param attribute The attribute to set
   /// @return void
-  void setAttribute(const Attribute attribute);
+  void setAttribute(Attribute attribute);
+
+  /// @brief Sets a position attribute & computes the geometry bounds from
+  /// the cpu values its buffer was created with, only for float xyz values
+  /// @param attribute The attribute to set
+  /// @param values The attribute' buffer values
+  /// @return void
+  void setAttribute(Attribute attribute, const std::span<const float> values);
+
+  /// @brief Sets every attribute of an interleaved buffer for the geometry
+  /// @param layout The layout of a single vertex in the buffer
+  /// @param buffer The interleaved vertex bytes
+  /// @param divisor The number of instances sharing a vertex, zero per vertex
+  /// @return void
+  void setInterleaved(
+    VertexLayout layout,
+    Uint8Buffer buffer,
+    const uint32_t divisor = 0
+  );
+
+  /// @brief Sets per-instance attributes read from a buffer owned elsewhere
+  /// The buffer must outlive the geometry, select instances of a ring buffer
+  /// slice through the base instance when drawing
+  /// @param instances The instance layout & buffer
+  /// @return void
+  void setInstances(Instances instances);
+
+  /// @brief Returns a geometry attribute for in-place buffer updates
+  /// @param name The name of the attribute
+  /// @return A reference to the attribute
+  Attribute &getAttribute(const std::string name);
+
+  /// @brief Returns the geometry index buffer for in-place updates
+  /// @return A reference to the index buffer
+  IndexVariant &getIndex();
 
   /// @brief Sets the geometry draw range
   /// @param range The draw range to apply to this geometry
@@ -61,35 +176,225 @@ public:
   void setRange(const Range range);
 
   /// @brief Sets the geometry draw range
-  /// @param start The draw range start index
-  /// @param count The draw range count
+  /// @param start The first vertex, or the first index with an index buffer
+  /// @param count The number of vertices, or of indices with an index buffer
+  /// @param baseVertex The value added to every index before fetching vertices
   /// @return void
-  void setRange(const uint16_t start, const uint16_t count);
+  void setRange(
+    const uint32_t start,
+    const uint32_t count,
+    const int32_t baseVertex = 0
+  );
+
+  /// @brief Returns the geometry draw range
+  /// @return The geometry draw range
+  const Range getRange() const;
+
+  /// @brief Sets the bounds enclosing the geometry positions
+  /// @param bounds The geometry bounds
+  /// @return void
+  void setBounds(const Bounds bounds);
+
+  /// @brief Returns the bounds enclosing the geometry positions
+  /// @return The geometry bounds or nothing when never computed
+  const std::optional<Bounds> getBounds() const;
 
   /// @brief Draws the geometry to the current context using a program
+  /// A non-zero base instance requires gl 4.2
   /// @param program The program to use to draw the geometry
+  /// @param instances The number of instances to draw
+  /// @param baseInstance The first instance read by per-instance attributes
   /// @return void
-  void draw(Program program);
+  void draw(
+    const Program &program,
+    const uint32_t instances = 1,
+    const uint32_t baseInstance = 0
+  );
+
+  /// @brief Draws indirect commands read from a gpu buffer
+  /// Commands are indexed, drawing a geometry without indices throws
+  /// @param program The program to use to draw the commands
+  /// @param buffer The gl identifier of the command buffer
+  /// @param count The number of commands to draw
+  /// @param offset The byte offset of the first command
+  /// @return void
+  void drawIndirect(
+    const Program &program,
+    const uint32_t buffer,
+    const uint32_t count,
+    const uint32_t offset = 0
+  );
+
+  /// @brief Draws indirect commands whose count is read from a gpu buffer
+  /// Requires gl 4.6, drawing a geometry without indices throws
+  /// @param program The program to use to draw the commands
+  /// @param buffer The gl identifier of the command buffer
+  /// @param parameter The gl identifier of the buffer holding the count
+  /// @param maxCount The maximum number of commands to draw
+  /// @param offset The byte offset of the first command
+  /// @param parameterOffset The byte offset of the count
+  /// @return void
+  void drawIndirectCount(
+    const Program &program,
+    const uint32_t buffer,
+    const uint32_t parameter,
+    const uint32_t maxCount,
+    const uint32_t offset = 0,
+    const uint32_t parameterOffset = 0
+  );
+
+  /// @brief Returns the command drawing this geometry' range through the
+  /// vertex arrays of another geometry sharing its buffers & layouts
+  /// @param base The geometry whose vertex arrays are used
+  /// @param instances The number of instances to draw
+  /// @param baseInstance The first instance read by per-instance attributes
+  /// @return The command or nothing when buffers or layouts differ
+  std::optional<DrawCommand> getIndirectCommand(
+    const Geometry &base,
+    const uint32_t instances = 1,
+    const uint32_t baseInstance = 0
+  ) const;
 
   /// @brief Destroys the vertex array instances
   /// @return void
   void destroy();
 
 private:
-  /// @brief The internal gl vertex array identifiers for specific programs
-  std::unordered_map<uint32_t, uint32_t> _ids;
+  /// @brief Stores a buffer binding & the layout of its values
+  struct Binding {
+    /// @brief The layout of the values read from the buffer
+    VertexLayout layout;
+
+    /// @brief The buffer' gl identifier
+    uint32_t buffer;
+
+    /// @brief The byte offset of the first value
+    uint32_t offset;
+
+    /// @brief The byte distance between consecutive values
+    int32_t stride;
+
+    /// @brief The number of instances sharing a value, zero per vertex
+    uint32_t divisor;
+  };
+
+  /// @brief Defines the signature of attribute locations, types & strides
+  typedef std::vector<uint32_t> Format;
+
+  /// @brief Hashes vertex format signatures
+  struct FormatHash {
+    /// @brief Combines every signature value into a single hash
+    /// @param format The vertex format signature
+    /// @return The signature hash
+    size_t operator()(const Format &format) const {
+      size_t hash = format.size();
+      for (const uint32_t value : format) {
+        hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+      }
+      return hash;
+    }
+  };
+
+  /// @brief Stores a vertex array & the buffers revision it binds
+  struct VertexArray {
+    /// @brief The vertex array' gl identifier
+    uint32_t id = 0;
+
+    /// @brief The geometry buffers revision bound to the vertex array
+    uint64_t revision = 0;
+
+    /// @brief The buffer arenas generation bound to the vertex array
+    uint64_t generation = 0;
+  };
+
+  /// @brief The vertex arrays keyed by vertex format, shared by programs
+  std::unordered_map<Format, VertexArray, FormatHash> _vertexArrays;
+
+  /// @brief The vertex array used by each program id
+  std::unordered_map<uint32_t, VertexArray *> _programs;
+
+  /// @brief The buffers revision, bumped whenever a buffer may be swapped
+  uint64_t _revision = 0;
+
+  /// @brief The layouts revision, bumped whenever the attribute set changes
+  uint64_t _layoutRevision = 0;
+
+  /// @brief The layouts revision the program vertex arrays were found for
+  uint64_t _programsRevision = 0;
 
   /// @brief The geometry' index buffer instance
-  std::optional<IndexBuffer> _index;
+  std::optional<IndexVariant> _index;
 
   /// @brief The geometry' buffer attributes
   std::unordered_map<std::string, Attribute> _attributes;
 
+  /// @brief The geometry' interleaved buffers
+  std::vector<Interleaved> _interleaved;
+
+  /// @brief The geometry' per-instance attributes from external buffers
+  std::vector<Instances> _instances;
+
   /// @brief The geometry' internal draw range reference
   Range _range;
 
-  /// @brief Creates a vertex array object for a specific program id
-  void createVAO(Program program);
+  /// @brief The bounds enclosing the geometry positions
+  std::optional<Bounds> _bounds;
+
+  /// @brief Creates a vertex array object for a specific program
+  /// @param vertexArray The vertex array to create
+  /// @param program The program whose active attributes are bound
+  /// @return void
+  void createVAO(VertexArray &vertexArray, const Program &program);
+
+  /// @brief Binds the geometry buffers & optionally the attribute formats
+  /// @param id The vertex array' gl identifier
+  /// @param program The program whose active attributes are bound
+  /// @param formats Whether to set formats or only swap buffers
+  /// @return void
+  void setupVAO(
+    const uint32_t id,
+    const Program &program,
+    const bool formats
+  ) const;
+
+  /// @brief Binds a buffer to a vertex array & points layout elements into it
+  /// @param id The vertex array' gl identifier
+  /// @param program The program whose active attributes are bound
+  /// @param binding The buffer & layout to bind
+  /// @param formats Whether to set formats or only swap the buffer
+  /// @return void
+  void bindLayout(
+    const uint32_t id,
+    const Program &program,
+    const Binding &binding,
+    const bool formats
+  ) const;
+
+  /// @brief Flushes the geometry buffers & binds the program' vertex array
+  /// @param program The program to draw the geometry with
+  /// @return void
+  void bindVAO(const Program &program);
+
+  /// @brief Returns the vertex format signature of the geometry for a program
+  /// @param program The program whose active attributes are read
+  /// @return The vertex format signature
+  Format getFormat(const Program &program) const;
+
+  /// @brief Returns every buffer binding, attributes sorted by name first
+  /// @return The buffer bindings
+  std::vector<Binding> getBindings() const;
+
+  /// @brief Uploads the pending updates of every geometry buffer
+  /// @return void
+  void flush();
+
+  /// @brief Binds the index buffer unless attached to the vertex array
+  /// @return The gl type of the indices
+  const uint32_t bindIndex() const;
+
+  /// @brief Returns the gl identifier of the index buffer
+  /// @return The gl identifier of the index buffer
+  const uint32_t getIndexId() const;
 };
 
 } // namespace stem
\ No newline at end of file
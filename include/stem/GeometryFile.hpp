@@ -0,0 +1,173 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include <stem/Bounds.hpp>
+#include <stem/Exception.hpp>
+#include <stem/Geometry.hpp>
+#include <stem/MappedFile.hpp>
+#include <stem/VertexLayout.hpp>
+
+namespace stem {
+
+class GeometryFileError : public Exception {
+public:
+  /// @brief GeometryFileError' class constructor
+  /// @param path The faulty file' path
+  /// @param reason What is wrong with the file
+  /// @return GeometryFileError
+  GeometryFileError(const std::string path, const std::string reason);
+};
+
+/// @brief Starts every .stemgeo file, followed by the element records, the
+/// interleaved vertices & the indices, each section 16 bytes aligned
+/// Values are stored little-endian, as every supported platform reads them
+struct GeometryFileHeader {
+  /// @brief The file signature, "STEMGEO" & a null byte
+  char magic[8] = {'S', 'T', 'E', 'M', 'G', 'E', 'O', '\0'};
+
+  /// @brief The format version
+  uint32_t version = 2;
+
+  /// @brief The number of vertex layout elements
+  uint32_t elementCount = 0;
+
+  /// @brief The byte size of a single vertex
+  uint32_t stride = 0;
+
+  /// @brief The number of vertices
+  uint32_t vertexCount = 0;
+
+  /// @brief The gl type of the indices, GL_NONE without indices
+  uint32_t indexType = 0;
+
+  /// @brief The number of indices
+  uint32_t indexCount = 0;
+
+  /// @brief The byte offset of the element records
+  uint64_t elementsOffset = 0;
+
+  /// @brief The byte offset of the vertices
+  uint64_t verticesOffset = 0;
+
+  /// @brief The byte offset of the indices
+  uint64_t indicesOffset = 0;
+
+  /// @brief The bounds of the position element
+  Bounds bounds;
+
+  /// @brief Whether the bounds were computed, only for float xyz positions
+  uint32_t bounded = 0;
+
+  /// @brief Pads the header to its 8 bytes alignment
+  uint32_t padding = 0;
+};
+
+/// @brief Describes a single vertex layout element inside a .stemgeo file
+struct GeometryFileElement {
+  /// @brief The null terminated attribute' name
+  char name[48] = {};
+
+  /// @brief The attribute' number of components
+  int32_t size = 1;
+
+  /// @brief The gl data type of the attribute' components
+  uint32_t type = 0;
+
+  /// @brief Whether fixed-point data values should be normalized
+  uint32_t normalized = 0;
+
+  /// @brief The attribute' byte offset inside a vertex
+  uint32_t offset = 0;
+};
+
+class GeometryFile {
+public:
+  /// @brief GeometryFile constructor mapping & validating a .stemgeo file
+  /// Platforms without mmap read the file into memory instead
+  /// @param path The file' path
+  /// @return GeometryFile
+  GeometryFile(const std::string path);
+
+  /// @brief GeometryFile move constructor taking ownership of the mapping
+  /// @param other The file to move from
+  /// @return GeometryFile
+  GeometryFile(GeometryFile &&other) noexcept;
+
+  /// @brief GeometryFile move assignment taking ownership of the mapping
+  /// @param other The file to move from
+  /// @return A reference to this file
+  GeometryFile &operator=(GeometryFile &&other) noexcept;
+
+  /// @brief Geometry files own their mapping & can not be copied
+  GeometryFile(const GeometryFile &) = delete;
+
+  /// @brief Geometry files own their mapping & can not be copied
+  GeometryFile &operator=(const GeometryFile &) = delete;
+
+  /// @brief GeometryFile destructor unmapping the file
+  ~GeometryFile();
+
+  /// @brief Uploads the mapped vertices & indices straight into a geometry
+  /// Throws when a section exceeds the 4 GiB a gl buffer can hold
+  /// @param usage The buffers' data usage method
+  /// @return The geometry
+  Geometry createGeometry(const uint32_t usage = GL_STATIC_DRAW) const;
+
+  /// @brief Returns the layout of a single vertex
+  /// @return The vertex layout
+  VertexLayout getLayout() const;
+
+  /// @brief Returns the mapped interleaved vertex bytes
+  /// @return The vertex bytes
+  const std::span<const uint8_t> getVertices() const;
+
+  /// @brief Returns the mapped index bytes
+  /// @return The index bytes
+  const std::span<const std::byte> getIndices() const;
+
+  /// @brief Returns the file header
+  /// @return The file header
+  const GeometryFileHeader &getHeader() const;
+
+  /// @brief Unmaps the file
+  /// @return void
+  void destroy();
+
+private:
+  /// @brief Checks the header, the element records & that every section
+  /// lies inside the file
+  /// @param path The file' path, for error messages
+  /// @return void
+  void validate(const std::string &path);
+
+  /// @brief The file' path, for error messages
+  std::string _path;
+
+  /// @brief The mapped file
+  MappedFile _file;
+
+  /// @brief The file header
+  GeometryFileHeader _header;
+};
+
+/// @brief Writes interleaved vertices & indices as a .stemgeo file
+/// Indices are narrowed to the smallest type able to hold them & bounds are
+/// computed from the float xyz element named position
+/// @param path The file' path
+/// @param layout The layout of a single vertex
+/// @param vertices The interleaved vertex bytes
+/// @param indices The triangle indices, empty for non indexed geometries
+/// @return void
+void writeGeometryFile(
+  const std::string path,
+  const VertexLayout &layout,
+  const std::span<const uint8_t> vertices,
+  const std::span<const uint32_t> indices = {}
+);
+
+} // namespace stem
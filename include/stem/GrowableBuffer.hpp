@@ -0,0 +1,109 @@
+#pragma once
+
+#include <span>
+#include <algorithm>
+#include <stem/Buffer.hpp>
+
+namespace stem {
+
+template <uint32_t GLBufferType, typename ValueType>
+class GrowableBuffer {
+public:
+  /// @brief The type of the buffer values
+  typedef ValueType Value;
+
+  /// @brief The buffer's data usage method
+  typedef typename Buffer<GLBufferType, ValueType>::Usage Usage;
+
+  /// @brief GrowableBuffer constructor
+  /// @param capacity The number of values the buffer can initially hold
+  /// @param usage The buffer's data usage method
+  /// @return GrowableBuffer
+  GrowableBuffer(
+    const uint32_t capacity = 64,
+    const Usage usage = Buffer<GLBufferType, ValueType>::Dynamic
+  );
+
+  /// @brief Appends values, growing the storage geometrically when full
+  /// @param values The values to append
+  /// @return The index of the first appended value
+  uint32_t append(const std::span<const ValueType> values);
+
+  /// @brief Records an update of a sub range of the appended values
+  /// @param offset The index of the first value to update
+  /// @param values The new values
+  /// @return void
+  void update(const uint32_t offset, const std::span<const ValueType> values);
+
+  /// @brief Grows the storage to hold at least a number of values
+  /// Existing values are copied on the gpu & never sent again
+  /// @param capacity The number of values the buffer must hold
+  /// @return void
+  void reserve(const uint32_t capacity);
+
+  /// @brief Discards every value while keeping the storage
+  /// @return void
+  void clear();
+
+  /// @brief Uploads the pending updates with as few calls as possible
+  /// @return void
+  void flush();
+
+  /// @brief Destroys the buffer instance
+  /// @return void
+  void destroy();
+
+  /// @brief Binds the buffer for usage
+  /// @return void
+  void bind() const;
+
+  /// @brief Returns the underlying buffer, which changes when growing
+  /// @return The underlying buffer
+  const Buffer<GLBufferType, ValueType> &getBuffer() const;
+
+  /// @brief Returns the current buffer id, which changes when growing
+  /// @return The current buffer id
+  const uint32_t getId() const;
+
+  /// @brief Returns the byte offset of the data in the gl buffer
+  /// @return The byte offset of the data in the gl buffer
+  const uint32_t getOffset() const;
+
+  /// @brief Returns the byte size of the appended values
+  /// @return The byte size of the appended values
+  const uint32_t getSize() const;
+
+  /// @brief Returns the number of appended values
+  /// @return The number of appended values
+  const uint32_t getCount() const;
+
+  /// @brief Returns the number of values the storage can hold
+  /// @return The number of values the storage can hold
+  const uint32_t getCapacity() const;
+
+  /// @brief Returns the current buffer type
+  /// @return The current buffer type
+  const uint32_t getType() const;
+
+private:
+  /// @brief The buffer's data usage method
+  Usage _usage;
+
+  /// @brief The number of appended values
+  uint32_t _count = 0;
+
+  /// @brief The number of values the storage can hold
+  uint32_t _capacity = 0;
+
+  /// @brief The underlying buffer holding the storage
+  Buffer<GLBufferType, ValueType> _buffer;
+};
+
+#include "GrowableBuffer.inl"
+
+// declare default growable buffer types
+typedef GrowableBuffer<GL_ARRAY_BUFFER, float> FloatGrowableBuffer;
+typedef GrowableBuffer<GL_ARRAY_BUFFER, uint32_t> Uint32GrowableBuffer;
+typedef GrowableBuffer<GL_ELEMENT_ARRAY_BUFFER, uint32_t> IndexGrowableBuffer;
+
+} // namespace stem
@@ -0,0 +1,109 @@
+template <uint32_t GLBufferType, typename ValueType>
+GrowableBuffer<GLBufferType, ValueType>::GrowableBuffer(
+  const uint32_t capacity,
+  const Usage usage
+) :
+  _usage(usage),
+  _capacity(std::max(capacity, 1u)),
+  _buffer(_capacity, usage) {}
+
+template <uint32_t GLBufferType, typename ValueType>
+uint32_t GrowableBuffer<GLBufferType, ValueType>::append(
+  const std::span<const ValueType> values
+) {
+  const uint32_t first = _count;
+
+  reserve(_count + values.size());
+  _count += values.size();
+  _buffer.update(first, values);
+
+  return first;
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+void GrowableBuffer<GLBufferType, ValueType>::update(
+  const uint32_t offset,
+  const std::span<const ValueType> values
+) {
+  // reject updates past the appended values
+  if (offset + values.size() > _count) {
+    throw BufferRangeError(
+      offset * sizeof(ValueType), values.size_bytes(), getSize()
+    );
+  }
+
+  _buffer.update(offset, values);
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+void GrowableBuffer<GLBufferType, ValueType>::reserve(const uint32_t capacity) {
+  if (capacity <= _capacity) return;
+
+  // grow geometrically so appends stay amortized constant time
+  _capacity = std::max(capacity, _capacity * 2);
+
+  // the gpu copy only sees uploaded values
+  _buffer.flush();
+
+  Buffer<GLBufferType, ValueType> buffer(_capacity, _usage);
+  _buffer.copyTo(buffer, 0, 0, getSize());
+  _buffer = std::move(buffer);
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+void GrowableBuffer<GLBufferType, ValueType>::clear() {
+  _count = 0;
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+void GrowableBuffer<GLBufferType, ValueType>::flush() {
+  _buffer.flush();
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+void GrowableBuffer<GLBufferType, ValueType>::destroy() {
+  _buffer.destroy();
+  _count = 0;
+  _capacity = 0;
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+void GrowableBuffer<GLBufferType, ValueType>::bind() const {
+  _buffer.bind();
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+const Buffer<GLBufferType, ValueType> &
+GrowableBuffer<GLBufferType, ValueType>::getBuffer() const {
+  return _buffer;
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+const uint32_t GrowableBuffer<GLBufferType, ValueType>::getId() const {
+  return _buffer.getId();
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+const uint32_t GrowableBuffer<GLBufferType, ValueType>::getOffset() const {
+  return _buffer.getOffset();
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+const uint32_t GrowableBuffer<GLBufferType, ValueType>::getSize() const {
+  return _count * sizeof(ValueType);
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+const uint32_t GrowableBuffer<GLBufferType, ValueType>::getCount() const {
+  return _count;
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+const uint32_t GrowableBuffer<GLBufferType, ValueType>::getCapacity() const {
+  return _capacity;
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+const uint32_t GrowableBuffer<GLBufferType, ValueType>::getType() const {
+  return _buffer.getType();
+}
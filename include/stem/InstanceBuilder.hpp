@@ -0,0 +1,60 @@
+#pragma once
+
+#include <span>
+#include <stem/RingBuffer.hpp>
+
+namespace stem {
+
+template <typename InstanceType>
+class InstanceBuilder {
+public:
+  /// @brief The type of the instance values
+  typedef InstanceType Value;
+
+  /// @brief InstanceBuilder constructor
+  /// Requires gl 4.4, instances live in a persistently mapped ring buffer
+  /// @param capacity The maximum number of instances per frame
+  /// @param frames The number of frame slices in flight
+  /// @return InstanceBuilder
+  InstanceBuilder(const uint32_t capacity, const uint32_t frames = 3);
+
+  /// @brief Starts a frame, waiting for its slice to be released by the gpu
+  /// @return void
+  void begin();
+
+  /// @brief Writes an instance into the current frame slice
+  /// @param instance The instance to write
+  /// @return Whether the instance fit in the frame slice
+  const bool push(const InstanceType &instance);
+
+  /// @brief Ends a frame once every draw reading its instances was issued
+  /// @return void
+  void end();
+
+  /// @brief Returns the number of instances written this frame
+  /// @return The number of instances written this frame
+  const uint32_t getCount() const;
+
+  /// @brief Returns the base instance selecting the current frame slice
+  /// Drawing with a non-zero base instance requires gl 4.2
+  /// @return The base instance selecting the current frame slice
+  const uint32_t getBaseInstance() const;
+
+  /// @brief Returns the gl identifier of the instance buffer
+  /// @return The gl identifier of the instance buffer
+  const uint32_t getId() const;
+
+private:
+  /// @brief The instance ring buffer
+  RingBuffer<GL_ARRAY_BUFFER, InstanceType> _ring;
+
+  /// @brief The mapped current frame slice
+  std::span<InstanceType> _slice;
+
+  /// @brief The number of instances written this frame
+  uint32_t _count = 0;
+};
+
+#include "InstanceBuilder.inl"
+
+} // namespace stem
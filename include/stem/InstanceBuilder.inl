@@ -0,0 +1,43 @@
+template <typename InstanceType>
+InstanceBuilder<InstanceType>::InstanceBuilder(
+  const uint32_t capacity,
+  const uint32_t frames
+) :
+  _ring(capacity, frames) {}
+
+template <typename InstanceType>
+void InstanceBuilder<InstanceType>::begin() {
+  _slice = _ring.map();
+  _count = 0;
+}
+
+template <typename InstanceType>
+const bool InstanceBuilder<InstanceType>::push(const InstanceType &instance) {
+  if (_count >= _slice.size()) return false;
+
+  // write straight into the persistently mapped slice
+  _slice[_count++] = instance;
+
+  return true;
+}
+
+template <typename InstanceType>
+void InstanceBuilder<InstanceType>::end() {
+  _ring.lock();
+  _slice = {};
+}
+
+template <typename InstanceType>
+const uint32_t InstanceBuilder<InstanceType>::getCount() const {
+  return _count;
+}
+
+template <typename InstanceType>
+const uint32_t InstanceBuilder<InstanceType>::getBaseInstance() const {
+  return _ring.getOffset() / sizeof(InstanceType);
+}
+
+template <typename InstanceType>
+const uint32_t InstanceBuilder<InstanceType>::getId() const {
+  return _ring.getId();
+}
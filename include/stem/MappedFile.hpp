@@ -0,0 +1,67 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include <stem/Exception.hpp>
+
+namespace stem {
+
+class MappedFileError : public Exception {
+public:
+  /// @brief MappedFileError' class constructor
+  /// @param path The faulty file' path
+  /// @param reason What went wrong with the file
+  /// @return MappedFileError
+  MappedFileError(const std::string path, const std::string reason);
+};
+
+class MappedFile {
+public:
+  /// @brief MappedFile constructor mapping a whole file read-only
+  /// Platforms without mmap read the file into memory instead
+  /// @param path The file' path
+  /// @return MappedFile
+  MappedFile(const std::string path);
+
+  /// @brief MappedFile move constructor taking ownership of the mapping
+  /// @param other The file to move from
+  /// @return MappedFile
+  MappedFile(MappedFile &&other) noexcept;
+
+  /// @brief MappedFile move assignment taking ownership of the mapping
+  /// @param other The file to move from
+  /// @return A reference to this file
+  MappedFile &operator=(MappedFile &&other) noexcept;
+
+  /// @brief Mapped files own their mapping & can not be copied
+  MappedFile(const MappedFile &) = delete;
+
+  /// @brief Mapped files own their mapping & can not be copied
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  /// @brief MappedFile destructor unmapping the file
+  ~MappedFile();
+
+  /// @brief Returns the file bytes, loaded from disk on first access
+  /// @return The file bytes
+  const std::span<const uint8_t> getData() const;
+
+  /// @brief Unmaps the file
+  /// @return void
+  void destroy();
+
+private:
+  /// @brief The mapped file bytes
+  const uint8_t *_data = nullptr;
+
+  /// @brief The byte size of the file
+  size_t _size = 0;
+
+  /// @brief The file bytes when read instead of mapped
+  std::vector<uint8_t> _storage;
+};
+
+} // namespace stem
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+namespace stem {
+
+/// @brief Stores the post-transform vertex cache efficiency of indices
+struct VertexCacheStatistics {
+  /// @brief The number of vertices transformed by the gpu
+  uint32_t transformed = 0;
+
+  /// @brief The average number of transformed vertices per triangle
+  float acmr = 0;
+
+  /// @brief The average number of transforms per referenced vertex
+  float atvr = 0;
+};
+
+/// @brief Stores the triangles using every vertex in compressed rows
+struct TriangleAdjacency {
+  /// @brief The first triangle of every vertex row, plus the end
+  std::vector<uint32_t> offsets;
+
+  /// @brief The triangles of every vertex row
+  std::vector<uint32_t> triangles;
+
+  /// @brief Builds the vertex to triangle adjacency of triangle indices
+  /// @param indices The triangle indices
+  /// @param vertexCount The number of vertices
+  /// @return TriangleAdjacency
+  TriangleAdjacency(
+    const std::span<const uint32_t> indices,
+    const uint32_t vertexCount
+  );
+};
+
+/// @brief Simulates a fifo post-transform vertex cache over triangle indices
+/// @param indices The triangle indices
+/// @param vertexCount The number of vertices
+/// @param cacheSize The number of cache entries
+/// @return The vertex cache statistics
+VertexCacheStatistics analyzeVertexCache(
+  const std::span<const uint32_t> indices,
+  const uint32_t vertexCount,
+  const uint32_t cacheSize = 16
+);
+
+/// @brief Reorders triangles for the post-transform vertex cache with tipsify
+/// @param indices The triangle indices to reorder in place
+/// @param vertexCount The number of vertices
+/// @param cacheSize The number of cache entries to optimize for
+/// @return void
+void optimizeVertexCache(
+  const std::span<uint32_t> indices,
+  const uint32_t vertexCount,
+  const uint32_t cacheSize = 16
+);
+
+/// @brief Reorders clusters of cache optimized triangles so the ones facing
+/// away from the mesh center are drawn first, reducing overdraw
+/// @param indices The cache optimized triangle indices to reorder in place
+/// @param positions The vertex positions, xyz first in every vertex
+/// @param stride The number of floats between consecutive vertex positions
+/// @param cacheSize The number of cache entries the indices are optimized for
+/// @param threshold The acmr ratio a cluster may lose to be split further
+/// @return void
+void optimizeOverdraw(
+  const std::span<uint32_t> indices,
+  const std::span<const float> positions,
+  const uint32_t stride = 3,
+  const uint32_t cacheSize = 16,
+  const float threshold = 1.05f
+);
+
+/// @brief Renumbers vertices in first use order for linear vertex fetches
+/// Vertices never referenced are mapped onto UINT32_MAX & dropped
+/// @param indices The triangle indices to rewrite in place
+/// @param vertexCount The number of vertices
+/// @return The new index of every vertex
+std::vector<uint32_t> optimizeVertexFetch(
+  const std::span<uint32_t> indices,
+  const uint32_t vertexCount
+);
+
+/// @brief Moves vertex values to their new index after a fetch optimization
+/// @param values The vertex values
+/// @param remap The new index of every vertex
+/// @param components The number of values per vertex
+/// @return The remapped vertex values
+template <typename ValueType>
+std::vector<ValueType> remapVertices(
+  const std::span<const ValueType> values,
+  const std::span<const uint32_t> remap,
+  const uint32_t components = 1
+) {
+  // count the vertices kept by the remap
+  uint32_t count = 0;
+  for (const uint32_t index : remap) {
+    if (index != UINT32_MAX) count = std::max(count, index + 1);
+  }
+
+  std::vector<ValueType> remapped(count * components);
+
+  for (size_t vertex = 0; vertex < remap.size(); vertex++) {
+    if (remap[vertex] == UINT32_MAX) continue;
+
+    std::copy_n(
+      values.begin() + vertex * components,
+      components,
+      remapped.begin() + remap[vertex] * components
+    );
+  }
+
+  return remapped;
+}
+
+} // namespace stem
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <span>
+#include <cfloat>
+#include <vector>
+#include <cstdint>
+
+#include <stem/Geometry.hpp>
+
+namespace stem {
+
+/// @brief Defines how far a mesh may be simplified & what it must preserve
+struct SimplifySettings {
+  /// @brief The number of indices to reduce the mesh to
+  uint32_t targetCount = 0;
+
+  /// @brief The largest distance collapses may move the surface by
+  float targetError = FLT_MAX;
+
+  /// @brief The number of floats between consecutive vertex positions
+  uint32_t stride = 3;
+
+  /// @brief The vertex attributes whose discontinuities are penalized
+  std::span<const float> attributes;
+
+  /// @brief The number of floats between consecutive vertex attributes
+  uint32_t attributeStride = 0;
+
+  /// @brief The weight of every attribute component, in position units
+  std::vector<float> weights;
+
+  /// @brief Whether vertices on open borders & seams are never collapsed
+  bool lockBorder = true;
+};
+
+/// @brief Stores simplified indices & the surface error they introduce
+struct Simplified {
+  /// @brief The simplified triangle indices, referencing the same vertices
+  std::vector<uint32_t> indices;
+
+  /// @brief The largest distance the surface moved by, in position units
+  float error = 0;
+};
+
+/// @brief Defines a single level of detail inside a lod chain
+struct LevelOfDetail {
+  /// @brief The range of the chain indices drawn by the level
+  Geometry::Range range;
+
+  /// @brief The largest distance from the full detail surface
+  float error = 0;
+};
+
+/// @brief Stores every level of detail in a single index array
+struct LodChain {
+  /// @brief The indices of every level, finest first
+  std::vector<uint32_t> indices;
+
+  /// @brief The levels of detail, finest first
+  std::vector<LevelOfDetail> levels;
+};
+
+/// @brief Simplifies triangles with quadric error metrics, collapsing edges
+/// onto their cheapest endpoint so vertex data is never rewritten
+/// @param indices The triangle indices to simplify
+/// @param positions The vertex positions, xyz first in every vertex
+/// @param settings The simplification target & constraints
+/// @return The simplified indices & their error
+Simplified simplify(
+  const std::span<const uint32_t> indices,
+  const std::span<const float> positions,
+  const SimplifySettings &settings
+);
+
+/// @brief Builds a chain of simplified levels sharing one vertex buffer
+/// Each level simplifies the previous one & is optimized for the
+/// vertex cache, upload the indices once & draw levels through their range
+/// @param indices The full detail triangle indices
+/// @param positions The vertex positions, xyz first in every vertex
+/// @param settings The constraints of every level, the count is ignored
+/// @param levels The maximum number of levels, full detail included
+/// @param ratio The fraction of triangles kept by every next level
+/// @return The lod chain
+LodChain createLodChain(
+  const std::span<const uint32_t> indices,
+  const std::span<const float> positions,
+  SimplifySettings settings,
+  const uint32_t levels = 4,
+  const float ratio = .5f
+);
+
+/// @brief Selects the coarsest level whose error stays under a pixel budget
+/// @param levels The levels of detail, finest first
+/// @param distance The distance from the camera to the mesh
+/// @param projectionScale The viewport height over 2 tan(fovy / 2)
+/// @param threshold The largest error allowed on screen, in pixels
+/// @return The index of the selected level
+uint32_t selectLod(
+  const std::span<const LevelOfDetail> levels,
+  const float distance,
+  const float projectionScale,
+  const float threshold = 1
+);
+
+} // namespace stem
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <cstdint>
+
+namespace stem {
+
+/// @brief Defines a cluster of triangles & its culling bounds, laid out as
+/// an std430 array element
+struct Meshlet {
+  /// @brief The bounding sphere center
+  float center[3] = {0, 0, 0};
+
+  /// @brief The bounding sphere radius
+  float radius = 0;
+
+  /// @brief The unit axis triangle normals spread around, zero when unbound
+  float axis[3] = {0, 0, 0};
+
+  /// @brief The sine of the normal cone half angle, one when unbound
+  float cutoff = 1;
+
+  /// @brief The first index of the cluster in the meshlet indices
+  uint32_t firstIndex = 0;
+
+  /// @brief The number of indices in the cluster
+  uint32_t count = 0;
+
+  /// @brief Pads the element to the std430 array stride
+  uint32_t padding[2] = {0, 0};
+};
+
+/// @brief Stores triangle indices reordered into contiguous meshlets
+struct MeshletMesh {
+  /// @brief The triangle indices, grouped by meshlet
+  std::vector<uint32_t> indices;
+
+  /// @brief The meshlets, in index order
+  std::vector<Meshlet> meshlets;
+};
+
+/// @brief Groups triangles into compact clusters sharing as many vertices as
+/// possible & computes their bounding spheres & normal cones
+/// A meshlet is back facing, and culled, when the camera satisfies
+/// dot(center - camera, axis) >= cutoff * length(center - camera) + radius
+/// @param indices The triangle indices
+/// @param positions The vertex positions, xyz first in every vertex
+/// @param stride The number of floats between consecutive vertex positions
+/// @param maxTriangles The maximum number of triangles per meshlet
+/// @return The reordered indices & their meshlets
+MeshletMesh buildMeshlets(
+  const std::span<const uint32_t> indices,
+  const std::span<const float> positions,
+  const uint32_t stride = 3,
+  const uint32_t maxTriangles = 128
+);
+
+} // namespace stem
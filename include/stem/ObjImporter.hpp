@@ -0,0 +1,61 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <string_view>
+
+#include <stem/Exception.hpp>
+#include <stem/Geometry.hpp>
+
+namespace stem {
+
+class ObjImportError : public Exception {
+public:
+  /// @brief ObjImportError' class constructor
+  /// @param path The faulty file' path
+  /// @param reason What is wrong with the file
+  /// @return ObjImportError
+  ObjImportError(const std::string path, const std::string reason);
+};
+
+/// @brief Stores a mesh read from a Wavefront obj file, one vertex per
+/// unique position, texture coordinate & normal triplet
+struct ObjMesh {
+  /// @brief The xyz vertex positions
+  std::vector<float> positions;
+
+  /// @brief The xyz vertex normals, empty when the file has none
+  std::vector<float> normals;
+
+  /// @brief The uv texture coordinates, empty when the file has none
+  std::vector<float> texcoords;
+
+  /// @brief The triangle indices, polygons triangulated as fans
+  std::vector<uint32_t> indices;
+
+  /// @brief Uploads the mesh as position, normal & uv attributes & indices
+  /// @param usage The buffers' data usage method
+  /// @return The geometry, bounded by its positions
+  Geometry createGeometry(const uint32_t usage = GL_STATIC_DRAW) const;
+};
+
+/// @brief Parses obj source text, splitting it into chunks parsed in parallel
+/// Only vertex, texture coordinate, normal & face statements are read
+/// @param source The obj source text
+/// @param threads The number of threads, zero for every hardware thread
+/// @param path The source' path, for error messages
+/// @return The indexed mesh
+ObjMesh parseObj(
+  const std::string_view source,
+  const uint32_t threads = 0,
+  const std::string path = "<memory>"
+);
+
+/// @brief Maps a Wavefront obj file & parses it in parallel
+/// @param path The file' path
+/// @param threads The number of threads, zero for every hardware thread
+/// @return The indexed mesh
+ObjMesh importObj(const std::string path, const uint32_t threads = 0);
+
+} // namespace stem
@@ -46,6 +46,9 @@ public:
   /// @brief Defines a simple uniform
   typedef std::pair<const std::string, const UniformValue> Uniform;
 
+  /// @brief Defines a named block assigned to an indexed binding point
+  typedef std::pair<const std::string, const uint32_t> BlockBinding;
+
   /// @brief Allowed settings when creating a program
   struct Settings {
     /// @brief The vertex shader source
@@ -57,8 +60,17 @@ public:
     /// @brief The geometry shader source
     const std::string geometry;
 
+    /// @brief The compute shader source, requires gl 4.3
+    const std::string compute;
+
     /// @brief The uniforms data
     const std::vector<Uniform> uniforms;
+
+    /// @brief The uniform blocks binding points
+    const std::vector<BlockBinding> uniformBlocks;
+
+    /// @brief The shader storage blocks binding points
+    const std::vector<BlockBinding> storageBlocks;
   };
 
   /// @brief Stores the state of an active uniform
@@ -106,6 +118,25 @@ public:
   /// @return Program
   Program(const Settings settings = Settings());
 
+  /// @brief Program move constructor taking ownership of the gl program
+  /// @param other The program to move from
+  /// @return Program
+  Program(Program &&other) noexcept;
+
+  /// @brief Program move assignment taking ownership of the gl program
+  /// @param other The program to move from
+  /// @return A reference to this program
+  Program &operator=(Program &&other) noexcept;
+
+  /// @brief Programs own their gl program & can not be copied
+  Program(const Program &) = delete;
+
+  /// @brief Programs own their gl program & can not be copied
+  Program &operator=(const Program &) = delete;
+
+  /// @brief Program destructor releasing the gl program
+  ~Program();
+
   /// @brief Returns the shader identifier
   /// @return The shader identifier
   const uint32_t getId() const;
@@ -121,6 +152,18 @@ public:
   /// @return void
   void setUniform(const Uniform uniform);
 
+  /// @brief Assigns a uniform block to a binding point if it exists
+  /// @param name The name of the uniform block
+  /// @param binding The uniform buffer binding point
+  /// @return void
+  void setUniformBlock(const std::string name, const uint32_t binding);
+
+  /// @brief Assigns a shader storage block to a binding point if it exists
+  /// @param name The name of the shader storage block
+  /// @param binding The shader storage buffer binding point
+  /// @return void
+  void setStorageBlock(const std::string name, const uint32_t binding);
+
   /// @brief Gets an active attribute from the program
   /// @param name The of the active attribute we're looking for
   /// @return An optional ActiveAttribute object
@@ -133,6 +176,14 @@ public:
   /// @return void
   void use();
 
+  /// @brief Binds the program & runs its compute shader over work groups
+  /// Requires gl 4.3
+  /// @param x The number of work groups along x
+  /// @param y The number of work groups along y
+  /// @param z The number of work groups along z
+  /// @return void
+  void dispatch(const uint32_t x, const uint32_t y = 1, const uint32_t z = 1);
+
   /// @brief Destroys the program instance
   /// @return void
   void destroy();
@@ -144,8 +195,13 @@ private:
   /// @return void
   inline void compile(const GLenum type, const std::string &source) const;
 
+  /// @brief Sends an active uniform' value to the program on the gpu
+  /// @param uniform The active uniform to upload
+  /// @return void
+  void upload(const ActiveUniform &uniform) const;
+
   /// @brief The internal gl program identifier
-  uint32_t _id;
+  uint32_t _id = 0;
 
   /// @brief The program' active uniforms
   std::unordered_map<std::string, ActiveUniform> _activeUniforms;
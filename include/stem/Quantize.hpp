@@ -0,0 +1,62 @@
+#pragma once
+
+#include <span>
+#include <stem/GLTypeTraits.hpp>
+
+namespace stem {
+
+/// @brief Converts floats to half precision floats, rounding to nearest even
+/// @param source The floats to convert
+/// @param target The converted values, as many as the shortest span
+/// @return void
+void quantize(
+  const std::span<const float> source,
+  const std::span<Half> target
+);
+
+/// @brief Converts floats clamped to [-1, 1] to signed normalized shorts
+/// @param source The floats to convert
+/// @param target The converted values, as many as the shortest span
+/// @return void
+void quantize(
+  const std::span<const float> source,
+  const std::span<Snorm16> target
+);
+
+/// @brief Converts floats clamped to [-1, 1] to signed normalized bytes
+/// @param source The floats to convert
+/// @param target The converted values, as many as the shortest span
+/// @return void
+void quantize(
+  const std::span<const float> source,
+  const std::span<Snorm8> target
+);
+
+/// @brief Converts floats clamped to [0, 1] to unsigned normalized shorts
+/// @param source The floats to convert
+/// @param target The converted values, as many as the shortest span
+/// @return void
+void quantize(
+  const std::span<const float> source,
+  const std::span<Unorm16> target
+);
+
+/// @brief Converts floats clamped to [0, 1] to unsigned normalized bytes
+/// @param source The floats to convert
+/// @param target The converted values, as many as the shortest span
+/// @return void
+void quantize(
+  const std::span<const float> source,
+  const std::span<Unorm8> target
+);
+
+/// @brief Packs xyzw quadruples clamped to [-1, 1] as 10, 10, 10 & 2 bits
+/// @param source The xyzw floats to pack
+/// @param target The packed values, one per quadruple
+/// @return void
+void quantize(
+  const std::span<const float> source,
+  const std::span<Int2101010> target
+);
+
+} // namespace stem
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <span>
+#include <deque>
+#include <cstdint>
+#include <optional>
+#include <glad/gl.h>
+
+namespace stem {
+
+class ReadbackQueue {
+public:
+  /// @brief Defines a handle identifying a requested readback
+  typedef uint64_t Ticket;
+
+  /// @brief ReadbackQueue constructor
+  /// Throws when the staging buffer can not be mapped
+  /// @param capacity The byte size of the persistently mapped read buffer
+  /// @return ReadbackQueue
+  ReadbackQueue(const uint32_t capacity = 4 * 1024 * 1024);
+
+  /// @brief ReadbackQueue move constructor taking ownership of the staging
+  /// @param other The queue to move from
+  /// @return ReadbackQueue
+  ReadbackQueue(ReadbackQueue &&other) noexcept;
+
+  /// @brief ReadbackQueue move assignment taking ownership of the staging
+  /// @param other The queue to move from
+  /// @return A reference to this queue
+  ReadbackQueue &operator=(ReadbackQueue &&other) noexcept;
+
+  /// @brief Readback queues own their staging buffer & can not be copied
+  ReadbackQueue(const ReadbackQueue &) = delete;
+
+  /// @brief Readback queues own their staging buffer & can not be copied
+  ReadbackQueue &operator=(const ReadbackQueue &) = delete;
+
+  /// @brief ReadbackQueue destructor releasing the staging buffer
+  ~ReadbackQueue();
+
+  /// @brief Copies a byte range of a gl buffer into the staging buffer
+  /// @param buffer The source gl buffer identifier
+  /// @param offset The source byte offset
+  /// @param size The number of bytes to read back
+  /// @return The readback ticket, or zero when the staging buffer is full
+  Ticket request(
+    const uint32_t buffer,
+    const uint32_t offset,
+    const uint32_t size
+  );
+
+  /// @brief Copies values of a stem buffer into the staging buffer
+  /// @param buffer The source buffer
+  /// @param offset The index of the first value to read back
+  /// @param count The number of values to read back
+  /// @return The readback ticket, or zero when the staging buffer is full
+  template <typename BufferType>
+  Ticket request(
+    const BufferType &buffer,
+    const uint32_t offset,
+    const uint32_t count
+  ) {
+    typedef typename BufferType::Value Value;
+
+    return request(
+      buffer.getId(),
+      buffer.getOffset() + offset * sizeof(Value),
+      count * sizeof(Value)
+    );
+  }
+
+  /// @brief Reads pixels of the bound read framebuffer into the staging buffer
+  /// Rows are padded to the default pack alignment of 4 bytes
+  /// @param x The left pixel coordinate
+  /// @param y The bottom pixel coordinate
+  /// @param width The number of pixels per row
+  /// @param height The number of rows
+  /// @param format The gl pixel format
+  /// @param type The gl pixel data type
+  /// @param pixelSize The byte size of a single pixel
+  /// @return The readback ticket, or zero when the staging buffer is full
+  Ticket requestPixels(
+    const int32_t x,
+    const int32_t y,
+    const uint32_t width,
+    const uint32_t height,
+    const uint32_t format,
+    const uint32_t type,
+    const uint32_t pixelSize
+  );
+
+  /// @brief Returns the read back values if the gpu completed the copy
+  /// The values stay valid until the ticket is released, throws when the
+  /// fence wait fails
+  /// @param ticket The readback ticket
+  /// @return The read back values or nothing if still in flight
+  template <typename ValueType = uint8_t>
+  std::optional<std::span<const ValueType>> poll(const Ticket ticket) {
+    const Readback *readback = find(ticket, false);
+    if (!readback) return {};
+
+    return view<ValueType>(*readback);
+  }
+
+  /// @brief Blocks until the gpu completed the copy
+  /// The values stay valid until the ticket is released, throws when the
+  /// fence wait fails
+  /// @param ticket The readback ticket
+  /// @return The read back values
+  template <typename ValueType = uint8_t>
+  std::span<const ValueType> wait(const Ticket ticket) {
+    const Readback *readback = find(ticket, true);
+    if (!readback) return {};
+
+    return view<ValueType>(*readback);
+  }
+
+  /// @brief Hands the staging range of a consumed readback back to the queue
+  /// @param ticket The readback ticket
+  /// @return void
+  void release(const Ticket ticket);
+
+  /// @brief Returns the number of staging bytes held by readbacks
+  /// @return The number of staging bytes held by readbacks
+  const uint32_t getUsedSize() const;
+
+  /// @brief Destroys the staging buffer & pending fences
+  /// @return void
+  void destroy();
+
+private:
+  /// @brief Stores a staging range written by the gpu
+  struct Readback {
+    /// @brief The readback ticket
+    Ticket ticket;
+
+    /// @brief The fence signaled when the copy completed, or null once seen
+    GLsync fence;
+
+    /// @brief The staging byte offset
+    uint32_t offset;
+
+    /// @brief The number of read back bytes
+    uint32_t size;
+
+    /// @brief The number of staging bytes skipped before the range, to align
+    /// it or to wrap around
+    uint32_t padding;
+
+    /// @brief Whether the values were consumed
+    bool released;
+  };
+
+  /// @brief Reserves an aligned staging range & records its readback
+  /// @param size The number of bytes to reserve
+  /// @return The recorded readback or null when the staging buffer is full
+  Readback *reserve(const uint32_t size);
+
+  /// @brief Fences the commands writing the latest readback
+  /// @param readback The latest readback
+  /// @return The readback ticket
+  Ticket fence(Readback &readback);
+
+  /// @brief Finds a readback & checks whether its copy completed
+  /// Throws when the fence wait fails
+  /// @param ticket The readback ticket
+  /// @param wait Whether to block until the copy completed
+  /// @return The completed readback or null
+  const Readback *find(const Ticket ticket, const bool wait);
+
+  /// @brief Returns a typed view over the staging range of a readback
+  /// @param readback The completed readback
+  /// @return The read back values
+  template <typename ValueType>
+  std::span<const ValueType> view(const Readback &readback) const {
+    return std::span<const ValueType>(
+      reinterpret_cast<const ValueType *>(_data + readback.offset),
+      readback.size / sizeof(ValueType)
+    );
+  }
+
+  /// @brief The staging buffer' gl identifier
+  uint32_t _id = 0;
+
+  /// @brief The staging buffer' byte size
+  uint32_t _capacity = 0;
+
+  /// @brief The persistently mapped staging memory
+  uint8_t *_data = nullptr;
+
+  /// @brief The staging write position
+  uint32_t _head = 0;
+
+  /// @brief The number of staging bytes held by readbacks
+  uint32_t _used = 0;
+
+  /// @brief The next ticket to hand out
+  Ticket _next = 1;
+
+  /// @brief The readbacks in request order
+  std::deque<Readback> _readbacks;
+};
+
+} // namespace stem
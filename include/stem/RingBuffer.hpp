@@ -0,0 +1,127 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <utility>
+#include <glad/gl.h>
+#include <stem/Error.hpp>
+#include <stem/GLTypeTraits.hpp>
+#include <stem/Capabilities.hpp>
+#include <stem/Exception.hpp>
+
+namespace stem {
+
+class BufferMapError : public Exception {
+public:
+  /// @brief BufferMapError' class constructor
+  /// @param id The faulty buffer' OpenGL identifier
+  /// @return BufferMapError
+  BufferMapError(const uint32_t id);
+};
+
+class FenceWaitError : public Exception {
+public:
+  /// @brief FenceWaitError' class constructor
+  /// @return FenceWaitError
+  FenceWaitError();
+};
+
+template <uint32_t GLBufferType, typename ValueType>
+class RingBuffer {
+public:
+  /// @brief RingBuffer constructor
+  /// Requires gl 4.4
+  /// @param count The number of values written per frame
+  /// @param frames The number of frame slices in flight
+  /// @return RingBuffer
+  RingBuffer(const uint32_t count, const uint32_t frames = 3);
+
+  /// @brief RingBuffer move constructor taking ownership of the gl buffer
+  /// @param other The ring buffer to move from
+  /// @return RingBuffer
+  RingBuffer(RingBuffer &&other) noexcept;
+
+  /// @brief RingBuffer move assignment taking ownership of the gl buffer
+  /// @param other The ring buffer to move from
+  /// @return A reference to this ring buffer
+  RingBuffer &operator=(RingBuffer &&other) noexcept;
+
+  /// @brief Ring buffers own their gl buffer & can not be copied
+  RingBuffer(const RingBuffer &) = delete;
+
+  /// @brief Ring buffers own their gl buffer & can not be copied
+  RingBuffer &operator=(const RingBuffer &) = delete;
+
+  /// @brief RingBuffer destructor releasing the gl buffer
+  ~RingBuffer();
+
+  /// @brief Waits for the current frame slice to be released by the gpu
+  /// @return A writable span over the current frame slice
+  std::span<ValueType> map();
+
+  /// @brief Fences the current frame slice & advances to the next one
+  /// @return void
+  void lock();
+
+  /// @brief Destroys the buffer instance
+  /// @return void
+  void destroy();
+
+  /// @brief Binds the buffer for usage
+  /// @return void
+  void bind() const;
+
+  /// @brief Returns the current buffer id
+  /// @return The current buffer id
+  const uint32_t getId() const;
+
+  /// @brief Returns the byte size of a single frame slice
+  /// @return The byte size of a single frame slice
+  const uint32_t getSize() const;
+
+  /// @brief Returns the byte offset of the current frame slice
+  /// @return The byte offset of the current frame slice
+  const uint32_t getOffset() const;
+
+  /// @brief Returns the current buffer type
+  /// @return The current buffer type
+  const uint32_t getType() const;
+
+private:
+  /// @brief Waits for a frame slice fence to be signaled & releases it
+  /// Throws when the wait fails, the gpu may still read the slice
+  /// @param frame The frame slice index to wait for
+  /// @return void
+  void wait(const uint32_t frame);
+
+  /// @brief The buffer' gl identifier
+  uint32_t _id = 0;
+
+  /// @brief The byte size of a single frame slice
+  uint32_t _size = 0;
+
+  /// @brief The number of values in a single frame slice
+  uint32_t _count = 0;
+
+  /// @brief The current frame slice index
+  uint32_t _frame = 0;
+
+  /// @brief The persistently mapped buffer memory
+  ValueType *_data = nullptr;
+
+  /// @brief The fences guarding each frame slice
+  std::vector<GLsync> _fences;
+
+  /// @brief The buffer' gl type
+  static constexpr uint32_t _type = GLTypeTraits<ValueType>::type;
+};
+
+#include "RingBuffer.inl"
+
+// declare default ring buffer types
+typedef RingBuffer<GL_ARRAY_BUFFER, float> FloatRingBuffer;
+typedef RingBuffer<GL_ARRAY_BUFFER, uint32_t> Uint32RingBuffer;
+typedef RingBuffer<GL_ARRAY_BUFFER, int32_t> Int32RingBuffer;
+typedef RingBuffer<GL_ELEMENT_ARRAY_BUFFER, uint32_t> IndexRingBuffer;
+
+} // namespace stem
@@ -0,0 +1,152 @@
+template <uint32_t GLBufferType, typename ValueType>
+RingBuffer<GLBufferType, ValueType>::RingBuffer(
+  const uint32_t count,
+  const uint32_t frames
+) :
+  _count(count), _fences(frames, nullptr) {
+  _size = count * sizeof(ValueType);
+
+  // allocate immutable storage for every frame slice & map it once
+  const GLbitfield flags =
+    GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+  if (hasDirectStateAccess()) {
+    glAssert(glCreateBuffers(1, &_id));
+    glAssert(glNamedBufferStorage(_id, _size * frames, nullptr, flags));
+    _data = static_cast<ValueType *>(
+      glMapNamedBufferRange(_id, 0, _size * frames, flags)
+    );
+  } else {
+    glAssert(glGenBuffers(1, &_id));
+    bind();
+
+    glAssert(glBufferStorage(GLBufferType, _size * frames, nullptr, flags));
+    _data = static_cast<ValueType *>(
+      glMapBufferRange(GLBufferType, 0, _size * frames, flags)
+    );
+  }
+
+  // release the storage rather than handing out a null slice
+  if (!_data) {
+    const uint32_t id = std::exchange(_id, 0);
+    glAssert(glDeleteBuffers(1, &id));
+    throw BufferMapError(id);
+  }
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+RingBuffer<GLBufferType, ValueType>::RingBuffer(RingBuffer &&other) noexcept {
+  *this = std::move(other);
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+RingBuffer<GLBufferType, ValueType> &
+RingBuffer<GLBufferType, ValueType>::operator=(RingBuffer &&other) noexcept {
+  if (this == &other) return *this;
+
+  // release our own storage before taking the other one
+  destroy();
+
+  _id = std::exchange(other._id, 0);
+  _size = other._size;
+  _count = other._count;
+  _frame = other._frame;
+  _data = std::exchange(other._data, nullptr);
+  _fences = std::exchange(other._fences, {});
+
+  return *this;
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+RingBuffer<GLBufferType, ValueType>::~RingBuffer() {
+  destroy();
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+std::span<ValueType> RingBuffer<GLBufferType, ValueType>::map() {
+  // make sure the gpu is done reading this slice
+  wait(_frame);
+
+  return std::span<ValueType>(_data + _frame * _count, _count);
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+void RingBuffer<GLBufferType, ValueType>::lock() {
+  // guard the slice until the commands issued so far have completed
+  if (_fences[_frame]) glAssert(glDeleteSync(_fences[_frame]));
+  glAssert(
+    _fences[_frame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0)
+  );
+
+  _frame = (_frame + 1) % _fences.size();
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+void RingBuffer<GLBufferType, ValueType>::wait(const uint32_t frame) {
+  GLsync &fence = _fences[frame];
+  if (!fence) return;
+
+  // flush once then keep polling until the fence is signaled
+  GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+
+  GLenum status;
+  do {
+    status = glClientWaitSync(fence, flags, 1000000);
+    flags = 0;
+  } while (status == GL_TIMEOUT_EXPIRED);
+
+  // a failed wait leaves the slice in use, keep the fence for destroy
+  if (status == GL_WAIT_FAILED) throw FenceWaitError();
+
+  glAssert(glDeleteSync(fence));
+  fence = nullptr;
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+void RingBuffer<GLBufferType, ValueType>::destroy() {
+  if (!_id) return;
+
+  // release pending fences
+  for (GLsync &fence : _fences) {
+    if (fence) glAssert(glDeleteSync(fence));
+    fence = nullptr;
+  }
+
+  // unmap & release the storage
+  if (hasDirectStateAccess()) {
+    glAssert(glUnmapNamedBuffer(_id));
+  } else {
+    bind();
+    glAssert(glUnmapBuffer(GLBufferType));
+  }
+
+  glAssert(glDeleteBuffers(1, &_id));
+
+  _data = nullptr;
+  _id = 0;
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+void RingBuffer<GLBufferType, ValueType>::bind() const {
+  glAssert(glBindBuffer(GLBufferType, _id));
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+const uint32_t RingBuffer<GLBufferType, ValueType>::getId() const {
+  return _id;
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+const uint32_t RingBuffer<GLBufferType, ValueType>::getSize() const {
+  return _size;
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+const uint32_t RingBuffer<GLBufferType, ValueType>::getOffset() const {
+  return _frame * _size;
+}
+
+template <uint32_t GLBufferType, typename ValueType>
+const uint32_t RingBuffer<GLBufferType, ValueType>::getType() const {
+  return _type;
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <span>
+#include <deque>
+#include <cstdint>
+#include <glad/gl.h>
+
+namespace stem {
+
+class UploadQueue {
+public:
+  /// @brief Defines a handle identifying an enqueued upload
+  typedef uint64_t Ticket;
+
+  /// @brief UploadQueue constructor
+  /// Throws when the staging buffer can not be mapped
+  /// @param capacity The byte size of the persistently mapped staging buffer
+  /// @return UploadQueue
+  UploadQueue(const uint32_t capacity = 16 * 1024 * 1024);
+
+  /// @brief UploadQueue move constructor taking ownership of the staging
+  /// @param other The queue to move from
+  /// @return UploadQueue
+  UploadQueue(UploadQueue &&other) noexcept;
+
+  /// @brief UploadQueue move assignment taking ownership of the staging
+  /// @param other The queue to move from
+  /// @return A reference to this queue
+  UploadQueue &operator=(UploadQueue &&other) noexcept;
+
+  /// @brief Upload queues own their staging buffer & can not be copied
+  UploadQueue(const UploadQueue &) = delete;
+
+  /// @brief Upload queues own their staging buffer & can not be copied
+  UploadQueue &operator=(const UploadQueue &) = delete;
+
+  /// @brief UploadQueue destructor releasing the staging buffer
+  ~UploadQueue();
+
+  /// @brief Enqueues an upload into a gl buffer
+  /// @param buffer The destination gl buffer identifier
+  /// @param offset The destination byte offset
+  /// @param data The source bytes, which must stay valid until resident
+  /// @param size The number of bytes to upload
+  /// @return The upload ticket
+  Ticket enqueue(
+    const uint32_t buffer,
+    const uint32_t offset,
+    const void *data,
+    const uint32_t size
+  );
+
+  /// @brief Enqueues an upload of values into a stem buffer
+  /// @param buffer The destination buffer
+  /// @param offset The index of the first destination value
+  /// @param values The source values, which must stay valid until resident
+  /// @return The upload ticket
+  template <typename BufferType, typename ValueType>
+  Ticket enqueue(
+    const BufferType &buffer,
+    const uint32_t offset,
+    const std::span<const ValueType> values
+  ) {
+    return enqueue(
+      buffer.getId(),
+      buffer.getOffset() + offset * sizeof(ValueType),
+      values.data(),
+      values.size_bytes()
+    );
+  }
+
+  /// @brief Stages pending uploads & retires the completed ones
+  /// Throws when a fence wait fails
+  /// @param budget The maximum number of bytes staged by this call
+  /// @return void
+  void update(const uint32_t budget = UINT32_MAX);
+
+  /// @brief Blocks until every enqueued upload is resident
+  /// Throws when a fence wait fails
+  /// @return void
+  void finish();
+
+  /// @brief Returns whether an upload reached its destination buffer
+  /// @param ticket The upload ticket
+  /// @return Whether the upload reached its destination buffer
+  const bool isResident(const Ticket ticket) const;
+
+  /// @brief Returns the number of bytes waiting to be staged
+  /// @return The number of bytes waiting to be staged
+  const uint64_t getPendingSize() const;
+
+  /// @brief Destroys the staging buffer & pending fences
+  /// @return void
+  void destroy();
+
+private:
+  /// @brief Stores an upload waiting to be staged
+  struct Upload {
+    /// @brief The destination gl buffer identifier
+    uint32_t buffer;
+
+    /// @brief The destination byte offset
+    uint32_t offset;
+
+    /// @brief The remaining source bytes
+    const uint8_t *data;
+
+    /// @brief The number of remaining bytes
+    uint32_t size;
+
+    /// @brief The upload ticket
+    Ticket ticket;
+  };
+
+  /// @brief Stores the staging range consumed by copies behind a fence
+  struct Batch {
+    /// @brief The fence signaled when the copies completed
+    GLsync fence;
+
+    /// @brief The number of staging bytes to release
+    uint32_t size;
+
+    /// @brief The last ticket made resident by the copies
+    Ticket ticket;
+  };
+
+  /// @brief Releases the staging range of signaled batches
+  /// Throws when a wait fails, the gpu may still read the staging range
+  /// @param wait Whether to block until every batch is signaled
+  /// @return void
+  void retire(const bool wait);
+
+  /// @brief Copies staged bytes into a destination buffer
+  /// @param buffer The destination gl buffer identifier
+  /// @param source The staging byte offset
+  /// @param offset The destination byte offset
+  /// @param size The number of bytes to copy
+  /// @return void
+  void copy(
+    const uint32_t buffer,
+    const uint32_t source,
+    const uint32_t offset,
+    const uint32_t size
+  ) const;
+
+  /// @brief The staging buffer' gl identifier
+  uint32_t _id = 0;
+
+  /// @brief The staging buffer' byte size
+  uint32_t _capacity = 0;
+
+  /// @brief The persistently mapped staging memory
+  uint8_t *_data = nullptr;
+
+  /// @brief The staging write position
+  uint32_t _head = 0;
+
+  /// @brief The number of staging bytes used by in flight batches
+  uint32_t _used = 0;
+
+  /// @brief The next ticket to hand out
+  Ticket _next = 1;
+
+  /// @brief The last fully staged ticket
+  Ticket _staged = 0;
+
+  /// @brief The last resident ticket
+  Ticket _resident = 0;
+
+  /// @brief The uploads waiting to be staged
+  std::deque<Upload> _pending;
+
+  /// @brief The in flight batches
+  std::deque<Batch> _batches;
+};
+
+} // namespace stem
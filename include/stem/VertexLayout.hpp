@@ -0,0 +1,102 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <glad/gl.h>
+#include <stem/Exception.hpp>
+
+namespace stem {
+
+class VertexLayoutError : public Exception {
+public:
+  /// @brief VertexLayoutError' class constructor
+  /// @param name The faulty element' name
+  /// @param count The faulty element' vertex count
+  /// @param expected The vertex count of the first element
+  /// @return VertexLayoutError
+  VertexLayoutError(
+    const std::string name,
+    const uint32_t count,
+    const uint32_t expected
+  );
+
+  /// @brief VertexLayoutError' class constructor for partial values
+  /// @param name The faulty element' name
+  /// @param size The faulty source' byte size
+  /// @return VertexLayoutError
+  VertexLayoutError(const std::string name, const uint32_t size);
+
+  /// @brief VertexLayoutError' class constructor for missing sources
+  /// @param sources The number of sources
+  /// @param elements The number of layout elements
+  /// @return VertexLayoutError
+  VertexLayoutError(const uint32_t sources, const uint32_t elements);
+};
+
+class VertexLayout {
+public:
+  /// @brief Defines a single attribute inside an interleaved vertex
+  struct Element {
+    /// @brief The attribute' name
+    std::string name;
+
+    /// @brief The attribute' number of components, matrices such as 9 for a
+    /// mat3 or 16 for a mat4 span one location per column
+    int32_t size = 1;
+
+    /// @brief The gl data type of the attribute' components
+    uint32_t type = GL_FLOAT;
+
+    /// @brief Whether fixed-point data values should be normalized
+    bool normalized = false;
+
+    /// @brief The attribute' byte offset inside a vertex, set by the layout
+    uint32_t offset = 0;
+  };
+
+  /// @brief VertexLayout constructor computing element offsets & stride
+  /// @param elements The elements of a vertex, in memory order
+  /// @return VertexLayout
+  VertexLayout(std::vector<Element> elements);
+
+  /// @brief Interleaves tightly packed arrays, one per element
+  /// Sources must match the elements & hold whole values of the same count
+  /// @param sources The element arrays, in element order
+  /// @return The interleaved vertex bytes
+  std::vector<uint8_t> interleave(
+    const std::vector<std::span<const std::byte>> &sources
+  ) const;
+
+  /// @brief Interleaves tightly packed typed arrays, one per element
+  /// @param sources The element arrays, in element order
+  /// @return The interleaved vertex bytes
+  template <typename... Ranges>
+  std::vector<uint8_t> interleave(const Ranges &...sources) const {
+    return interleave({std::as_bytes(std::span(sources))...});
+  }
+
+  /// @brief Returns the layout' elements
+  /// @return The layout' elements
+  const std::vector<Element> &getElements() const;
+
+  /// @brief Returns the byte size of a single vertex
+  /// @return The byte size of a single vertex
+  const uint32_t getStride() const;
+
+  /// @brief Returns the byte size of an element inside a vertex
+  /// @param element The element to measure
+  /// @return The byte size of the element
+  static const uint32_t getSize(const Element &element);
+
+private:
+  /// @brief The layout' elements
+  std::vector<Element> _elements;
+
+  /// @brief The byte size of a single vertex
+  uint32_t _stride = 0;
+};
+
+} // namespace stem
@@ -0,0 +1,194 @@
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+
+#include <stem/Bounds.hpp>
+
+#if defined(__x86_64__) || defined(_M_X64)
+  #define STEM_SSE2
+  #include <immintrin.h>
+#endif
+
+#if defined(STEM_SSE2) && (defined(__GNUC__) || defined(__clang__))
+  #define STEM_AVX
+#endif
+
+namespace stem {
+
+namespace {
+
+/// @brief The largest stride reduced with vector registers
+constexpr uint32_t MAX_VECTOR_STRIDE = 16;
+
+#ifdef STEM_SSE2
+
+/// @brief Reduces positions to their min & max 4 vertices at a time
+/// Each block loads stride registers, so lane j of register r always holds
+/// component (r * 4 + j) % stride
+/// @param positions The first position float
+/// @param blocks The number of 4 vertices blocks to reduce
+/// @param stride The number of floats between consecutive vertex positions
+/// @param min The smallest coordinates to lower
+/// @param max The largest coordinates to raise
+/// @return void
+void reduceSSE(
+  const float *positions,
+  const size_t blocks,
+  const uint32_t stride,
+  float *min,
+  float *max
+) {
+  __m128 low[MAX_VECTOR_STRIDE], high[MAX_VECTOR_STRIDE];
+
+  for (uint32_t r = 0; r < stride; r++) {
+    low[r] = _mm_set1_ps(FLT_MAX);
+    high[r] = _mm_set1_ps(-FLT_MAX);
+  }
+
+  for (size_t block = 0; block < blocks; block++) {
+    for (uint32_t r = 0; r < stride; r++) {
+      const __m128 values = _mm_loadu_ps(positions + (block * stride + r) * 4);
+      low[r] = _mm_min_ps(low[r], values);
+      high[r] = _mm_max_ps(high[r], values);
+    }
+  }
+
+  // fold every lane onto the component it holds
+  for (uint32_t r = 0; r < stride; r++) {
+    float lows[4], highs[4];
+    _mm_storeu_ps(lows, low[r]);
+    _mm_storeu_ps(highs, high[r]);
+
+    for (uint32_t lane = 0; lane < 4; lane++) {
+      const uint32_t component = (r * 4 + lane) % stride;
+      if (component >= 3) continue;
+
+      min[component] = std::min(min[component], lows[lane]);
+      max[component] = std::max(max[component], highs[lane]);
+    }
+  }
+}
+
+#endif
+
+#ifdef STEM_AVX
+
+/// @brief Reduces positions to their min & max 8 vertices at a time
+/// @param positions The first position float
+/// @param blocks The number of 8 vertices blocks to reduce
+/// @param stride The number of floats between consecutive vertex positions
+/// @param min The smallest coordinates to lower
+/// @param max The largest coordinates to raise
+/// @return void
+__attribute__((target("avx"))) void reduceAVX(
+  const float *positions,
+  const size_t blocks,
+  const uint32_t stride,
+  float *min,
+  float *max
+) {
+  __m256 low[MAX_VECTOR_STRIDE], high[MAX_VECTOR_STRIDE];
+
+  for (uint32_t r = 0; r < stride; r++) {
+    low[r] = _mm256_set1_ps(FLT_MAX);
+    high[r] = _mm256_set1_ps(-FLT_MAX);
+  }
+
+  for (size_t block = 0; block < blocks; block++) {
+    for (uint32_t r = 0; r < stride; r++) {
+      const __m256 values =
+        _mm256_loadu_ps(positions + (block * stride + r) * 8);
+      low[r] = _mm256_min_ps(low[r], values);
+      high[r] = _mm256_max_ps(high[r], values);
+    }
+  }
+
+  for (uint32_t r = 0; r < stride; r++) {
+    float lows[8], highs[8];
+    _mm256_storeu_ps(lows, low[r]);
+    _mm256_storeu_ps(highs, high[r]);
+
+    for (uint32_t lane = 0; lane < 8; lane++) {
+      const uint32_t component = (r * 8 + lane) % stride;
+      if (component >= 3) continue;
+
+      min[component] = std::min(min[component], lows[lane]);
+      max[component] = std::max(max[component], highs[lane]);
+    }
+  }
+}
+
+/// @brief Returns whether the cpu supports avx instructions
+/// @return Whether the cpu supports avx instructions
+bool hasAVX() {
+  static const bool supported = __builtin_cpu_supports("avx");
+  return supported;
+}
+
+#endif
+
+} // namespace
+
+Bounds computeBounds(
+  const std::span<const float> positions,
+  const uint32_t stride
+) {
+  Bounds bounds;
+  if (stride < 3 || positions.size() < 3) return bounds;
+
+  // the last vertex only needs its position
+  const size_t count = (positions.size() - 3) / stride + 1;
+  size_t vertex = 0;
+
+  float min[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+  float max[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+
+  // vector blocks must read whole vertices inside the span
+  const size_t whole = positions.size() / stride;
+
+#ifdef STEM_AVX
+  if (hasAVX() && stride <= MAX_VECTOR_STRIDE) {
+    const size_t blocks = whole / 8;
+    reduceAVX(positions.data(), blocks, stride, min, max);
+    vertex = blocks * 8;
+  }
+#endif
+
+#ifdef STEM_SSE2
+  if (stride <= MAX_VECTOR_STRIDE && whole - vertex >= 4) {
+    const size_t blocks = (whole - vertex) / 4;
+    reduceSSE(&positions[vertex * stride], blocks, stride, min, max);
+    vertex += blocks * 4;
+  }
+#endif
+
+  for (; vertex < count; vertex++) {
+    for (uint32_t axis = 0; axis < 3; axis++) {
+      min[axis] = std::min(min[axis], positions[vertex * stride + axis]);
+      max[axis] = std::max(max[axis], positions[vertex * stride + axis]);
+    }
+  }
+
+  for (uint32_t axis = 0; axis < 3; axis++) {
+    bounds.min[axis] = min[axis];
+    bounds.max[axis] = max[axis];
+    bounds.center[axis] = (min[axis] + max[axis]) / 2;
+  }
+
+  // enclose the farthest position from the box center
+  float radius = 0;
+
+  for (vertex = 0; vertex < count; vertex++) {
+    const float *p = &positions[vertex * stride];
+    const float x = p[0] - bounds.center[0];
+    const float y = p[1] - bounds.center[1];
+    const float z = p[2] - bounds.center[2];
+    radius = std::max(radius, x * x + y * y + z * z);
+  }
+
+  bounds.radius = std::sqrt(radius);
+
+  return bounds;
+}
+
+} // namespace stem
@@ -0,0 +1,74 @@
+#include <algorithm>
+
+#include <stem/Buffer.hpp>
+
+namespace stem {
+
+BufferRangeError::BufferRangeError(
+  const uint32_t offset,
+  const uint32_t size,
+  const uint32_t capacity
+) {
+  _message = "Buffer range [" + std::to_string(offset) + ", " +
+             std::to_string(offset + size) + ") exceeds buffer size " +
+             std::to_string(capacity);
+}
+
+ImmutableBufferError::ImmutableBufferError(const uint32_t id) {
+  _message = "Buffer " + std::to_string(id) + " has immutable storage";
+}
+
+void copyBufferData(
+  const uint32_t source,
+  const uint32_t target,
+  const uint32_t sourceOffset,
+  const uint32_t targetOffset,
+  const uint32_t size
+) {
+  if (hasDirectStateAccess()) {
+    glAssert(glCopyNamedBufferSubData(
+      source, target, sourceOffset, targetOffset, size
+    ));
+    return;
+  }
+
+  // use the copy targets to keep array & element bindings untouched
+  glAssert(glBindBuffer(GL_COPY_READ_BUFFER, source));
+  glAssert(glBindBuffer(GL_COPY_WRITE_BUFFER, target));
+  glAssert(glCopyBufferSubData(
+    GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, sourceOffset, targetOffset, size
+  ));
+}
+
+const uint32_t selectIndexType(const uint32_t maxIndex) {
+  if (maxIndex <= UINT8_MAX) return GL_UNSIGNED_BYTE;
+  if (maxIndex <= UINT16_MAX) return GL_UNSIGNED_SHORT;
+
+  return GL_UNSIGNED_INT;
+}
+
+IndexVariant createIndexBuffer(
+  const std::span<const uint32_t> indices,
+  const uint32_t usage
+) {
+  // find the largest index to pick the index width
+  uint32_t maxIndex = 0;
+  for (const uint32_t index : indices) {
+    maxIndex = std::max(maxIndex, index);
+  }
+
+  switch (selectIndexType(maxIndex)) {
+  case GL_UNSIGNED_BYTE: {
+    const std::vector<uint8_t> narrow(indices.begin(), indices.end());
+    return Index8Buffer(narrow, (Index8Buffer::Usage)usage);
+  }
+  case GL_UNSIGNED_SHORT: {
+    const std::vector<uint16_t> narrow(indices.begin(), indices.end());
+    return Index16Buffer(narrow, (Index16Buffer::Usage)usage);
+  }
+  default:
+    return IndexBuffer(indices, (IndexBuffer::Usage)usage);
+  }
+}
+
+} // namespace stem
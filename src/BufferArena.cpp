@@ -0,0 +1,203 @@
+#include <optional>
+#include <algorithm>
+
+#include <stem/Error.hpp>
+#include <stem/Capabilities.hpp>
+#include <stem/BufferArena.hpp>
+
+namespace stem {
+
+BufferArena::BufferArena(const uint32_t pageSize, const uint32_t usage) :
+  _pageSize(pageSize), _usage(usage) {
+}
+
+BufferArena::~BufferArena() {
+  destroy();
+}
+
+uint64_t BufferArena::_generation = 0;
+
+std::shared_ptr<const BufferArena::Allocation>
+BufferArena::allocate(const uint32_t size, const uint32_t alignment) {
+  if (!size) return nullptr;
+
+  // attempt to fit the range in an existing page
+  uint32_t index = 0;
+  std::optional<uint32_t> offset;
+
+  for (; index < _pages.size(); index++) {
+    offset = _pages[index].blocks.allocate(size, alignment);
+    if (offset) break;
+  }
+
+  // create a new page large enough for the range
+  if (!offset) {
+    const uint32_t capacity = std::max(_pageSize, size);
+    _pages.push_back({createBuffer(capacity), FreeList(capacity), {}});
+    offset = _pages.back().blocks.allocate(size, alignment).value();
+  }
+
+  Page &page = _pages[index];
+  auto allocation = std::make_shared<Allocation>(
+    Allocation{page.id, *offset, size, index, this}
+  );
+
+  page.live.emplace(*offset, Block{alignment, allocation});
+
+  return allocation;
+}
+
+void BufferArena::free(const Allocation *allocation) {
+  if (!allocation || allocation->page >= _pages.size()) return;
+
+  // only release ranges that are still live & owned by the record
+  Page &page = _pages[allocation->page];
+  const auto iterator = page.live.find(allocation->offset);
+  if (iterator == page.live.end()) return;
+  if (iterator->second.allocation.get() != allocation) return;
+
+  page.blocks.free(allocation->offset, allocation->size);
+  page.live.erase(iterator);
+}
+
+void BufferArena::upload(
+  const Allocation &allocation,
+  const void *data,
+  const uint32_t size,
+  const uint32_t offset
+) {
+  if (!size) return;
+
+  if (hasDirectStateAccess()) {
+    glAssert(glNamedBufferSubData(
+      allocation.buffer, allocation.offset + offset, size, data
+    ));
+    return;
+  }
+
+  // use the copy target to keep array & element bindings untouched
+  glAssert(glBindBuffer(GL_COPY_WRITE_BUFFER, allocation.buffer));
+  glAssert(glBufferSubData(
+    GL_COPY_WRITE_BUFFER, allocation.offset + offset, size, data
+  ));
+}
+
+void BufferArena::defragment(const Relocation &relocation) {
+  bool moved = false;
+
+  for (uint32_t index = 0; index < _pages.size(); index++) {
+    Page &page = _pages[index];
+    if (isCompact(page)) continue;
+
+    const uint32_t capacity = page.blocks.getCapacity();
+    const uint32_t id = createBuffer(capacity);
+
+    FreeList blocks(capacity);
+    std::map<uint32_t, Block> live;
+
+    const bool dsa = hasDirectStateAccess();
+    if (!dsa) {
+      glAssert(glBindBuffer(GL_COPY_READ_BUFFER, page.id));
+      glAssert(glBindBuffer(GL_COPY_WRITE_BUFFER, id));
+    }
+
+    // repack live ranges in order & copy them on the gpu
+    for (auto &[offset, block] : page.live) {
+      Allocation &allocation = *block.allocation;
+      const uint32_t target =
+        blocks.allocate(allocation.size, block.alignment).value();
+
+      if (dsa) {
+        glAssert(glCopyNamedBufferSubData(
+          page.id, id, offset, target, allocation.size
+        ));
+      } else {
+        glAssert(glCopyBufferSubData(
+          GL_COPY_READ_BUFFER,
+          GL_COPY_WRITE_BUFFER,
+          offset,
+          target,
+          allocation.size
+        ));
+      }
+
+      // patch the record its owner reads the buffer & offset from
+      const Allocation from = allocation;
+      allocation = {id, target, allocation.size, index, this};
+      if (relocation) relocation(from, allocation);
+
+      live.emplace(target, std::move(block));
+    }
+
+    // swap the fragmented page for the compact one
+    glAssert(glDeleteBuffers(1, &page.id));
+    page = {id, std::move(blocks), std::move(live)};
+    moved = true;
+  }
+
+  // vertex arrays compare generations to rebind moved buffers
+  if (moved) _generation++;
+}
+
+void BufferArena::destroy() {
+  for (Page &page : _pages) {
+    // detach buffers outliving the arena from the deleted page
+    for (auto &[offset, block] : page.live) {
+      *block.allocation = {};
+    }
+
+    glAssert(glDeleteBuffers(1, &page.id));
+  }
+
+  _pages.clear();
+}
+
+const uint32_t BufferArena::getPageCount() const {
+  return _pages.size();
+}
+
+const uint32_t BufferArena::getUsedSize() const {
+  uint32_t size = 0;
+
+  for (const Page &page : _pages) {
+    size += page.blocks.getCapacity() - page.blocks.getFreeSize();
+  }
+
+  return size;
+}
+
+const uint64_t BufferArena::getGeneration() {
+  return _generation;
+}
+
+uint32_t BufferArena::createBuffer(const uint32_t size) const {
+  uint32_t id;
+
+  if (hasDirectStateAccess()) {
+    glAssert(glCreateBuffers(1, &id));
+    glAssert(glNamedBufferData(id, size, nullptr, _usage));
+    return id;
+  }
+
+  glAssert(glGenBuffers(1, &id));
+  glAssert(glBindBuffer(GL_COPY_WRITE_BUFFER, id));
+  glAssert(glBufferData(GL_COPY_WRITE_BUFFER, size, nullptr, _usage));
+
+  return id;
+}
+
+bool BufferArena::isCompact(const Page &page) {
+  const uint32_t free = page.blocks.getFreeSize();
+  const uint32_t capacity = page.blocks.getCapacity();
+
+  // a single free block may still sit between live ranges
+  uint32_t end = 0;
+  if (!page.live.empty()) {
+    const auto &[offset, block] = *page.live.rbegin();
+    end = offset + block.allocation->size;
+  }
+
+  return page.blocks.getBlockCount() <= 1 && end + free == capacity;
+}
+
+} // namespace stem
@@ -0,0 +1,11 @@
+#include <glad/gl.h>
+#include <stem/Capabilities.hpp>
+
+namespace stem {
+
+const bool hasDirectStateAccess() {
+  // direct state access is core since gl 4.5
+  return GLAD_GL_VERSION_4_5 != 0;
+}
+
+} // namespace stem
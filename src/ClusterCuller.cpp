@@ -0,0 +1,124 @@
+#include <algorithm>
+
+#include <stem/Error.hpp>
+#include <stem/ClusterCuller.hpp>
+
+namespace stem {
+
+const std::string ClusterCuller::SOURCE = R"(
+#version 430
+
+layout(local_size_x = 64) in;
+
+struct Meshlet {
+  vec4 sphere;
+  vec4 cone;
+  uint firstIndex;
+  uint count;
+};
+
+layout(std430, binding = 0) readonly buffer Meshlets {
+  Meshlet meshlets[];
+};
+
+layout(std430, binding = 1) writeonly buffer Commands {
+  uint commands[];
+};
+
+layout(std430, binding = 2) buffer Count {
+  uint count;
+};
+
+layout(std140, binding = 0) uniform Parameters {
+  vec4 planes[6];
+  vec4 camera;
+  uint firstIndex;
+  int baseVertex;
+  uint meshletCount;
+};
+
+void main() {
+  uint index = gl_GlobalInvocationID.x;
+  if (index >= meshletCount) return;
+
+  Meshlet meshlet = meshlets[index];
+  vec3 center = meshlet.sphere.xyz;
+  float radius = meshlet.sphere.w;
+
+  for (int plane = 0; plane < 6; plane++) {
+    if (dot(planes[plane].xyz, center) + planes[plane].w < -radius) return;
+  }
+
+  vec3 view = center - camera.xyz;
+  float facing = meshlet.cone.w * length(view) + radius;
+  if (dot(view, meshlet.cone.xyz) >= facing) return;
+
+  uint command = atomicAdd(count, 1u) * 5u;
+  commands[command] = meshlet.count;
+  commands[command + 1u] = 1u;
+  commands[command + 2u] = firstIndex + meshlet.firstIndex;
+  commands[command + 3u] = uint(baseVertex);
+  commands[command + 4u] = 0u;
+}
+)";
+
+ClusterCuller::ClusterCuller(const std::span<const Meshlet> meshlets) :
+  _program({.compute = SOURCE}),
+  _meshlets(meshlets, ShaderStorageBuffer<Meshlet>::Static),
+  _commands(
+    std::max<uint32_t>(meshlets.size(), 1),
+    ShaderStorageBuffer<DrawCommand>::Dynamic
+  ),
+  _count(1, ShaderStorageBuffer<uint32_t>::Dynamic),
+  _parameters(1, UniformBuffer<Parameters>::Dynamic) {}
+
+void ClusterCuller::cull(const Geometry &geometry, const View &view) {
+  // reset the count before the pass appends to it
+  const uint32_t zero = 0;
+  _count.update(0, std::span(&zero, 1));
+  _count.flush();
+
+  // meshlets are offset by the geometry draw range
+  const std::optional<DrawCommand> range =
+    geometry.getIndirectCommand(geometry);
+
+  const uint32_t count = range ? _meshlets.getCount() : 0;
+  if (!count) return;
+
+  Parameters parameters = {view, range->firstIndex, range->baseVertex, count};
+  _parameters.update(0, std::span(&parameters, 1));
+  _parameters.flush();
+
+  _meshlets.bindBase(0);
+  _commands.bindBase(1);
+  _count.bindBase(2);
+  _parameters.bindBase(0);
+
+  _program.dispatch((count + GROUP_SIZE - 1) / GROUP_SIZE);
+
+  // make the commands & count visible to indirect draws
+  glAssert(glMemoryBarrier(GL_COMMAND_BARRIER_BIT));
+}
+
+void ClusterCuller::draw(Geometry &geometry, const Program &program) {
+  geometry.drawIndirectCount(
+    program,
+    _commands.getId(),
+    _count.getId(),
+    _meshlets.getCount()
+  );
+}
+
+const uint32_t ClusterCuller::getCommandsId() const {
+  return _commands.getId();
+}
+
+const uint32_t ClusterCuller::getCountId() const {
+  return _count.getId();
+}
+
+const uint32_t ClusterCuller::getCount() const {
+  return _meshlets.getCount();
+}
+
+} // namespace stem
@@ -0,0 +1,238 @@
+#include <bit>
+#include <algorithm>
+
+#include <stem/Error.hpp>
+#include <stem/RingBuffer.hpp>
+#include <stem/Capabilities.hpp>
+#include <stem/DeletionQueue.hpp>
+
+namespace stem {
+
+DeletionQueue *DeletionQueue::_current = nullptr;
+
+DeletionQueue::DeletionQueue(const uint32_t poolSize) : _poolSize(poolSize) {}
+
+DeletionQueue::DeletionQueue(DeletionQueue &&other) noexcept {
+  *this = std::move(other);
+}
+
+DeletionQueue &DeletionQueue::operator=(DeletionQueue &&other) noexcept {
+  if (this == &other) return *this;
+
+  // release our own objects before taking the other ones
+  destroy();
+
+  _poolSize = other._poolSize;
+  _pooled = std::exchange(other._pooled, 0);
+  _objects = std::exchange(other._objects, {});
+  _frames = std::exchange(other._frames, {});
+  _pool = std::exchange(other._pool, {});
+
+  if (_current == &other) _current = this;
+
+  return *this;
+}
+
+DeletionQueue::~DeletionQueue() {
+  destroy();
+
+  if (_current == this) _current = nullptr;
+}
+
+void DeletionQueue::makeCurrent() {
+  _current = this;
+}
+
+DeletionQueue *DeletionQueue::getCurrent() {
+  return _current;
+}
+
+uint32_t DeletionQueue::createBuffer(
+  const uint32_t size,
+  const uint32_t usage
+) {
+  // reuse the name & storage of a released buffer, pooled buffers of a
+  // class hold at least the class size
+  const auto iterator = _pool.find({getSizeClass(size), usage});
+  if (iterator != _pool.end() && !iterator->second.empty()) {
+    const Pooled pooled = iterator->second.back();
+    iterator->second.pop_back();
+    _pooled -= pooled.size;
+
+    return pooled.id;
+  }
+
+  // new buffers get their exact size, only recycling rounds sizes
+  uint32_t id;
+
+  if (hasDirectStateAccess()) {
+    glAssert(glCreateBuffers(1, &id));
+    glAssert(glNamedBufferData(id, size, nullptr, usage));
+    return id;
+  }
+
+  glAssert(glGenBuffers(1, &id));
+  glAssert(glBindBuffer(GL_COPY_WRITE_BUFFER, id));
+  glAssert(glBufferData(GL_COPY_WRITE_BUFFER, size, nullptr, usage));
+
+  return id;
+}
+
+void DeletionQueue::deleteBuffer(const uint32_t id) {
+  _objects.push_back({BufferObject, id});
+}
+
+void DeletionQueue::deleteProgram(const uint32_t id) {
+  _objects.push_back({ProgramObject, id});
+}
+
+void DeletionQueue::deleteVertexArray(const uint32_t id) {
+  _objects.push_back({VertexArrayObject, id});
+}
+
+void DeletionQueue::update() {
+  // guard this frame' objects until its commands have completed
+  if (!_objects.empty()) {
+    const GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    _frames.push_back({fence, std::exchange(_objects, {})});
+  }
+
+  retire(false);
+}
+
+void DeletionQueue::finish() {
+  update();
+  retire(true);
+}
+
+const uint64_t DeletionQueue::getPoolSize() const {
+  return _pooled;
+}
+
+void DeletionQueue::destroy() {
+  // gl defers deleting objects the gpu still uses, nothing is recycled here
+  for (const Frame &frame : _frames) {
+    glAssert(glDeleteSync(frame.fence));
+
+    for (const Object &object : frame.objects) {
+      discard(object);
+    }
+  }
+
+  for (const Object &object : _objects) {
+    discard(object);
+  }
+
+  _frames.clear();
+  _objects.clear();
+
+  for (const auto &[key, buffers] : _pool) {
+    for (const Pooled &pooled : buffers) {
+      glAssert(glDeleteBuffers(1, &pooled.id));
+    }
+  }
+
+  _pool.clear();
+  _pooled = 0;
+}
+
+const uint32_t DeletionQueue::getSizeClass(const uint32_t size) {
+  if (size <= 256) return 256;
+
+  // round up to a quarter of the power of two below the size
+  const uint32_t step = std::bit_floor(size - 1) / 4;
+  return (size + step - 1) / step * step;
+}
+
+uint32_t DeletionQueue::getPoolClass(const uint32_t size) {
+  if (size < 256) return 0;
+
+  // round down to a quarter of the power of two below the size
+  const uint32_t step = std::bit_floor(size) / 4;
+  return size / step * step;
+}
+
+void DeletionQueue::retire(const bool wait) {
+  while (!_frames.empty()) {
+    Frame &frame = _frames.front();
+
+    // poll or block on the oldest frame
+    const GLenum status = glClientWaitSync(
+      frame.fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, wait ? 1000000 : 0
+    );
+
+    if (status == GL_TIMEOUT_EXPIRED) {
+      if (wait) continue;
+      break;
+    }
+
+    // a failed wait leaves the objects in use, never recycle them
+    if (status == GL_WAIT_FAILED) throw FenceWaitError();
+
+    glAssert(glDeleteSync(frame.fence));
+
+    for (const Object &object : frame.objects) {
+      release(object);
+    }
+
+    _frames.pop_front();
+  }
+}
+
+void DeletionQueue::release(const Object &object) {
+  if (object.kind != BufferObject) {
+    discard(object);
+    return;
+  }
+
+  // query the storage to find out whether it can be recycled
+  int32_t size = 0, usage = 0, immutable = 0;
+
+  if (hasDirectStateAccess()) {
+    glAssert(glGetNamedBufferParameteriv(object.id, GL_BUFFER_SIZE, &size));
+    glAssert(glGetNamedBufferParameteriv(object.id, GL_BUFFER_USAGE, &usage));
+    glAssert(glGetNamedBufferParameteriv(
+      object.id, GL_BUFFER_IMMUTABLE_STORAGE, &immutable
+    ));
+  } else {
+    glAssert(glBindBuffer(GL_COPY_WRITE_BUFFER, object.id));
+    glAssert(
+      glGetBufferParameteriv(GL_COPY_WRITE_BUFFER, GL_BUFFER_SIZE, &size)
+    );
+    glAssert(
+      glGetBufferParameteriv(GL_COPY_WRITE_BUFFER, GL_BUFFER_USAGE, &usage)
+    );
+    glAssert(glGetBufferParameteriv(
+      GL_COPY_WRITE_BUFFER, GL_BUFFER_IMMUTABLE_STORAGE, &immutable
+    ));
+  }
+
+  // mutable storage is recycled under the largest class its size holds
+  const uint32_t sizeClass = getPoolClass(std::max(size, 0));
+  const bool recyclable =
+    !immutable && sizeClass && _pooled + size <= _poolSize;
+
+  if (!recyclable) {
+    discard(object);
+    return;
+  }
+
+  _pool[{sizeClass, (uint32_t)usage}].push_back({object.id, (uint32_t)size});
+  _pooled += size;
+}
+
+void DeletionQueue::discard(const Object &object) {
+  if (object.kind == ProgramObject) {
+    glAssert(glDeleteProgram(object.id));
+    return;
+  }
+
+  if (object.kind == VertexArrayObject) {
+    glAssert(glDeleteVertexArrays(1, &object.id));
+    return;
+  }
+
+  glAssert(glDeleteBuffers(1, &object.id));
+}
+
+} // namespace stem
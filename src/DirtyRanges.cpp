@@ -0,0 +1,73 @@
+#include <cstring>
+#include <iterator>
+#include <algorithm>
+
+#include <stem/DirtyRanges.hpp>
+
+namespace stem {
+
+void DirtyRanges::write(
+  const uint32_t offset,
+  const void *data,
+  const uint32_t size
+) {
+  if (!size) return;
+
+  uint32_t begin = offset;
+  uint32_t end = offset + size;
+
+  // find the first range that could touch the write
+  auto first = _ranges.upper_bound(begin);
+  if (first != _ranges.begin()) {
+    auto previous = std::prev(first);
+    if (previous->first + previous->second.size() >= begin) first = previous;
+  }
+
+  // write fully inside an existing range is a plain copy
+  if (
+    first != _ranges.end() && first->first <= begin &&
+    first->first + first->second.size() >= end
+  ) {
+    std::memcpy(&first->second[begin - first->first], data, size);
+    return;
+  }
+
+  // find the range past the last one touching the write
+  auto last = first;
+  while (last != _ranges.end() && last->first <= end) {
+    begin = std::min(begin, last->first);
+    end = std::max(end, last->first + (uint32_t)last->second.size());
+    last++;
+  }
+
+  // copy the touched ranges then the write on top of them
+  std::vector<uint8_t> bytes(end - begin);
+
+  for (auto iterator = first; iterator != last; iterator++) {
+    std::memcpy(
+      &bytes[iterator->first - begin],
+      iterator->second.data(),
+      iterator->second.size()
+    );
+  }
+
+  std::memcpy(&bytes[offset - begin], data, size);
+
+  // replace the touched ranges with the merged one
+  _ranges.erase(first, last);
+  _ranges.emplace(begin, std::move(bytes));
+}
+
+const DirtyRanges::Ranges &DirtyRanges::getRanges() const {
+  return _ranges;
+}
+
+const bool DirtyRanges::empty() const {
+  return _ranges.empty();
+}
+
+void DirtyRanges::clear() {
+  _ranges.clear();
+}
+
+} // namespace stem
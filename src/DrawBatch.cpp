@@ -0,0 +1,63 @@
+#include <stem/DrawBatch.hpp>
+
+namespace stem {
+
+DrawBatch::DrawBatch(const uint32_t capacity) : _commands(capacity) {}
+
+const bool DrawBatch::add(
+  Geometry &geometry,
+  const uint32_t instances,
+  const uint32_t baseInstance
+) {
+  const Geometry &base = _base ? *_base : geometry;
+  const std::optional<DrawCommand> command =
+    geometry.getIndirectCommand(base, instances, baseInstance);
+  if (!command) return false;
+
+  // the first accepted geometry anchors the vertex arrays of the batch
+  if (!_base) _base = &geometry;
+
+  _commands.append(std::span<const DrawCommand>(&*command, 1));
+
+  return true;
+}
+
+void DrawBatch::submit(const Program &program) {
+  if (!_base || !_commands.getCount()) return;
+
+  _commands.flush();
+  _base->drawIndirect(program, _commands.getId(), _commands.getCount());
+}
+
+void DrawBatch::submitCount(
+  const Program &program,
+  const uint32_t parameter,
+  const uint32_t parameterOffset
+) {
+  if (!_base || !_commands.getCount()) return;
+
+  _commands.flush();
+  _base->drawIndirectCount(
+    program,
+    _commands.getId(),
+    parameter,
+    _commands.getCount(),
+    0,
+    parameterOffset
+  );
+}
+
+void DrawBatch::clear() {
+  _commands.clear();
+  _base = nullptr;
+}
+
+const uint32_t DrawBatch::getCount() const {
+  return _commands.getCount();
+}
+
+const uint32_t DrawBatch::getId() const {
+  return _commands.getId();
+}
+
+} // namespace stem
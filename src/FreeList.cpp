@@ -0,0 +1,104 @@
+#include <iterator>
+
+#include <stem/FreeList.hpp>
+
+namespace stem {
+
+FreeList::FreeList(const uint32_t capacity) :
+  _capacity(capacity), _free(0) {
+  insert(0, capacity);
+}
+
+std::optional<uint32_t>
+FreeList::allocate(const uint32_t size, const uint32_t alignment) {
+  if (!size) return {};
+
+  // walk blocks from the smallest one that could fit
+  auto iterator = _sizes.lower_bound(size);
+  for (; iterator != _sizes.end(); iterator++) {
+    const uint32_t blockSize = iterator->first;
+    const uint32_t blockOffset = iterator->second;
+
+    // align the offset inside the block
+    const uint32_t offset =
+      (blockOffset + alignment - 1) / alignment * alignment;
+    const uint32_t padding = offset - blockOffset;
+    if (padding + size > blockSize) continue;
+
+    // split the block & give back the padding and the remainder
+    erase(blockOffset, blockSize);
+    if (padding) insert(blockOffset, padding);
+    if (padding + size < blockSize) {
+      insert(offset + size, blockSize - padding - size);
+    }
+
+    return offset;
+  }
+
+  return {};
+}
+
+void FreeList::free(const uint32_t offset, const uint32_t size) {
+  if (!size) return;
+
+  uint32_t begin = offset;
+  uint32_t end = offset + size;
+
+  // merge with the following free block
+  auto next = _offsets.lower_bound(offset);
+  if (next != _offsets.end() && next->first == end) {
+    end += next->second;
+    erase(next->first, next->second);
+  }
+
+  // merge with the preceding free block
+  auto previous = _offsets.lower_bound(offset);
+  if (previous != _offsets.begin()) {
+    previous = std::prev(previous);
+
+    if (previous->first + previous->second == begin) {
+      begin = previous->first;
+      erase(previous->first, previous->second);
+    }
+  }
+
+  insert(begin, end - begin);
+}
+
+const uint32_t FreeList::getCapacity() const {
+  return _capacity;
+}
+
+const uint32_t FreeList::getFreeSize() const {
+  return _free;
+}
+
+const uint32_t FreeList::getLargestBlock() const {
+  return _sizes.empty() ? 0 : _sizes.rbegin()->first;
+}
+
+const uint32_t FreeList::getBlockCount() const {
+  return _offsets.size();
+}
+
+void FreeList::insert(const uint32_t offset, const uint32_t size) {
+  _offsets.emplace(offset, size);
+  _sizes.emplace(size, offset);
+  _free += size;
+}
+
+void FreeList::erase(const uint32_t offset, const uint32_t size) {
+  _offsets.erase(offset);
+  _free -= size;
+
+  // find the matching size entry among equally sized blocks
+  auto [first, last] = _sizes.equal_range(size);
+  for (auto iterator = first; iterator != last; iterator++) {
+    if (iterator->second != offset) continue;
+
+    _sizes.erase(iterator);
+    return;
+  }
+}
+
+} // namespace stem
@@ -0,0 +1,196 @@
+#include <cmath>
+#include <string>
+#include <algorithm>
+
+#include <stem/Frustum.hpp>
+
+#if defined(__x86_64__) || defined(_M_X64)
+  #define STEM_SSE2
+  #include <immintrin.h>
+#endif
+
+#if defined(STEM_SSE2) && (defined(__GNUC__) || defined(__clang__))
+  #define STEM_AVX
+#endif
+
+namespace stem {
+
+namespace {
+
+#ifdef STEM_AVX
+
+/// @brief Tests boxes against planes 8 at a time with the positive vertex
+/// of every box, the corner furthest along the plane normal
+/// @param planes The normalized planes, facing inside
+/// @param bounds The boxes to test
+/// @param mask The visibility bits
+/// @return The number of boxes tested
+__attribute__((target("avx"))) uint32_t cullAVX(
+  const float (&planes)[6][4],
+  const BoundsList &bounds,
+  uint8_t *mask
+) {
+  const uint32_t count = bounds.getCount() / 8 * 8;
+
+  // broadcast every plane component once
+  __m256 components[6][4];
+  for (uint32_t plane = 0; plane < 6; plane++) {
+    for (uint32_t axis = 0; axis < 4; axis++) {
+      components[plane][axis] = _mm256_set1_ps(planes[plane][axis]);
+    }
+  }
+
+  for (uint32_t index = 0; index < count; index += 8) {
+    const __m256 minX = _mm256_loadu_ps(&bounds.minX[index]);
+    const __m256 minY = _mm256_loadu_ps(&bounds.minY[index]);
+    const __m256 minZ = _mm256_loadu_ps(&bounds.minZ[index]);
+    const __m256 maxX = _mm256_loadu_ps(&bounds.maxX[index]);
+    const __m256 maxY = _mm256_loadu_ps(&bounds.maxY[index]);
+    const __m256 maxZ = _mm256_loadu_ps(&bounds.maxZ[index]);
+
+    __m256 visible = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+    for (uint32_t plane = 0; plane < 6; plane++) {
+      const __m256 x = components[plane][0];
+      const __m256 y = components[plane][1];
+      const __m256 z = components[plane][2];
+
+      // the larger product of each axis picks the positive vertex
+      const __m256 distanceX =
+        _mm256_max_ps(_mm256_mul_ps(x, minX), _mm256_mul_ps(x, maxX));
+      const __m256 distanceY =
+        _mm256_max_ps(_mm256_mul_ps(y, minY), _mm256_mul_ps(y, maxY));
+      const __m256 distanceZ =
+        _mm256_max_ps(_mm256_mul_ps(z, minZ), _mm256_mul_ps(z, maxZ));
+
+      const __m256 distance = _mm256_add_ps(
+        _mm256_add_ps(distanceX, distanceY),
+        _mm256_add_ps(distanceZ, components[plane][3])
+      );
+
+      const __m256 inside =
+        _mm256_cmp_ps(distance, _mm256_setzero_ps(), _CMP_GE_OQ);
+      visible = _mm256_and_ps(visible, inside);
+    }
+
+    mask[index / 8] = (uint8_t)_mm256_movemask_ps(visible);
+  }
+
+  return count;
+}
+
+/// @brief Returns whether the cpu supports avx instructions
+/// @return Whether the cpu supports avx instructions
+bool hasAVX() {
+  static const bool supported = __builtin_cpu_supports("avx");
+  return supported;
+}
+
+#endif
+
+} // namespace
+
+void BoundsList::push(const Bounds &bounds) {
+  minX.push_back(bounds.min[0]);
+  minY.push_back(bounds.min[1]);
+  minZ.push_back(bounds.min[2]);
+  maxX.push_back(bounds.max[0]);
+  maxY.push_back(bounds.max[1]);
+  maxZ.push_back(bounds.max[2]);
+}
+
+void BoundsList::clear() {
+  minX.clear();
+  minY.clear();
+  minZ.clear();
+  maxX.clear();
+  maxY.clear();
+  maxZ.clear();
+}
+
+const uint32_t BoundsList::getCount() const {
+  return minX.size();
+}
+
+CullMaskError::CullMaskError(const uint32_t size, const uint32_t expected) {
+  _message = "Cull mask has " + std::to_string(size) + " bytes, expected " +
+             std::to_string(expected);
+}
+
+Frustum::Frustum(const std::span<const float, 16> matrix) {
+  // combine the last row with every other one, gribb & hartmann style
+  for (uint32_t plane = 0; plane < 6; plane++) {
+    const uint32_t row = plane / 2;
+    const float sign = plane % 2 ? -1.f : 1.f;
+
+    for (uint32_t column = 0; column < 4; column++) {
+      _planes[plane][column] =
+        matrix[column * 4 + 3] + sign * matrix[column * 4 + row];
+    }
+
+    const float length = std::sqrt(
+      _planes[plane][0] * _planes[plane][0] +
+      _planes[plane][1] * _planes[plane][1] +
+      _planes[plane][2] * _planes[plane][2]
+    );
+
+    if (length <= 0) continue;
+
+    for (uint32_t column = 0; column < 4; column++) {
+      _planes[plane][column] /= length;
+    }
+  }
+}
+
+const bool Frustum::intersects(const Bounds &bounds) const {
+  for (const float *plane : _planes) {
+    float distance = plane[3];
+
+    for (uint32_t axis = 0; axis < 3; axis++) {
+      distance += std::max(
+        plane[axis] * bounds.min[axis], plane[axis] * bounds.max[axis]
+      );
+    }
+
+    if (distance < 0) return false;
+  }
+
+  return true;
+}
+
+void Frustum::cull(
+  const BoundsList &bounds,
+  const std::span<uint8_t> mask
+) const {
+  const uint32_t count = bounds.getCount();
+  uint32_t index = 0;
+
+  // every box writes a bit of the mask
+  const uint32_t bytes = (count + 7) / 8;
+  if (mask.size() < bytes) throw CullMaskError(mask.size(), bytes);
+
+#ifdef STEM_AVX
+  if (hasAVX()) index = cullAVX(_planes, bounds, mask.data());
+#endif
+
+  // test the remaining boxes one by one
+  for (; index < count; index++) {
+    Bounds box;
+    box.min[0] = bounds.minX[index];
+    box.min[1] = bounds.minY[index];
+    box.min[2] = bounds.minZ[index];
+    box.max[0] = bounds.maxX[index];
+    box.max[1] = bounds.maxY[index];
+    box.max[2] = bounds.maxZ[index];
+
+    const uint8_t bit = 1 << (index % 8);
+    if (index % 8 == 0) mask[index / 8] = 0;
+    if (intersects(box)) mask[index / 8] |= bit;
+  }
+}
+
+const std::span<const float, 24> Frustum::getPlanes() const {
+  return std::span<const float, 24>(&_planes[0][0], 24);
+}
+
+} // namespace stem
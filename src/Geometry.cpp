@@ -1,118 +1,624 @@
+#include <map>
+#include <utility>
 #include <algorithm>
 
 #include <stem/Error.hpp>
+#include <stem/Capabilities.hpp>
+#include <stem/DeletionQueue.hpp>
 #include <stem/Geometry.hpp>
 
 namespace stem {
 
-Geometry::Geometry(const std::vector<Attribute> attributes) {
-  // iterate and set attributes
-  for (Attribute attribute : attributes) {
-    setAttribute(attribute);
+namespace {
+
+/// @brief Returns the number of components per column of an element
+/// Elements above 4 components are matrices with columns of 3 for 3x3 & 2x3
+/// sizes & of 4 otherwise
+/// @param size The element' number of components
+/// @return The number of components per column
+int32_t getColumnHeight(const int32_t size) {
+  if (size <= 4) return size;
+  if (size % 4 && size % 3 == 0) return 3;
+
+  return 4;
+}
+
+} // namespace
+
+IndirectDrawError::IndirectDrawError() {
+  _message = "Indirect draws require an index buffer";
+}
+
+Geometry::Geometry(std::vector<Attribute> attributes) {
+  // iterate and move attributes in
+  for (Attribute &attribute : attributes) {
+    setAttribute(std::move(attribute));
   }
 }
 
-void Geometry::setIndex(const IndexBuffer index) {
-  _index = index;
+Geometry::Geometry(Geometry &&other) noexcept {
+  *this = std::move(other);
 }
 
-void Geometry::setAttribute(const Attribute attribute) {
-  // store the attribute
-  _attributes.try_emplace(attribute.name, attribute);
+Geometry &Geometry::operator=(Geometry &&other) noexcept {
+  if (this == &other) return *this;
+
+  // release our own gl objects before taking the other ones
+  destroy();
 
+  _vertexArrays = std::exchange(other._vertexArrays, {});
+  _programs = std::exchange(other._programs, {});
+  _revision = other._revision;
+  _layoutRevision = other._layoutRevision;
+  _programsRevision = other._programsRevision;
+  _index = std::exchange(other._index, std::nullopt);
+  _attributes = std::exchange(other._attributes, {});
+  _interleaved = std::exchange(other._interleaved, {});
+  _instances = std::exchange(other._instances, {});
+  _range = other._range;
+  _bounds = std::exchange(other._bounds, std::nullopt);
+
+  return *this;
+}
+
+Geometry::~Geometry() {
+  destroy();
+}
+
+void Geometry::setIndex(IndexVariant index) {
+  // attaching the first index buffer changes the vertex format
+  if (!_index) _layoutRevision++;
+
+  _index = std::move(index);
+
+  // draw every index by default
+  const auto getCount = [](auto &&index) { return index.getCount(); };
+  _range = {0, std::visit(getCount, *_index)};
+
+  // attach the new index buffer to existing vertex arrays on next draw
+  _revision++;
+}
+
+void Geometry::setAttribute(Attribute attribute) {
   // generate update draw range count lambda
-  const auto updateRangeCount = [this, attribute](auto &&buffer) -> void {
-    _range.count = std::max(_range.count, (uint16_t)(buffer.getSize() / attribute.size));
+  const int32_t size = attribute.size;
+  const auto updateRangeCount = [this, size](auto &&buffer) -> void {
+    typedef typename std::remove_cvref_t<decltype(buffer)>::Value Value;
+
+    // packed values hold every component of a vertex
+    const uint32_t count = GLTypeTraits<Value>::packed
+                             ? buffer.getCount()
+                             : buffer.getCount() / std::max(size, 1);
+    _range.count = std::max(_range.count, count);
   };
 
-  // visit buffer & update draw range count
-  std::visit(updateRangeCount, attribute.buffer);
+  // indexed draw ranges count indices & instances do not count at all
+  if (!_index && !attribute.divisor) {
+    std::visit(updateRangeCount, attribute.buffer);
+  }
+
+  // store the attribute, swapping the buffer of an existing one
+  const std::string name = attribute.name;
+  _attributes.insert_or_assign(name, std::move(attribute));
+  _revision++;
+  _layoutRevision++;
+}
+
+void Geometry::setAttribute(
+  Attribute attribute,
+  const std::span<const float> values
+) {
+  // read positions from the attribute' first value & stride
+  const uint32_t offset = attribute.offset / sizeof(float);
+  const uint32_t stride = attribute.stride
+                            ? attribute.stride / sizeof(float)
+                            : std::max(attribute.size, 1);
+
+  // only float xyz positions can be bounded, others are never culled
+  const auto getType = [](auto &&buffer) { return buffer.getType(); };
+  const bool positions = attribute.size >= 3 && stride >= 3 &&
+                         std::visit(getType, attribute.buffer) == GL_FLOAT;
+
+  _bounds = std::nullopt;
+  if (positions && offset < values.size()) {
+    _bounds = computeBounds(values.subspan(offset), stride);
+  }
+
+  setAttribute(std::move(attribute));
+}
+
+void Geometry::setInterleaved(
+  VertexLayout layout,
+  Uint8Buffer buffer,
+  const uint32_t divisor
+) {
+  // update draw range count from the number of whole vertices
+  const uint32_t stride = layout.getStride();
+  if (stride && !_index && !divisor) {
+    const uint32_t count = buffer.getSize() / stride;
+    _range.count = std::max(_range.count, count);
+  }
+
+  _interleaved.push_back({std::move(layout), std::move(buffer), divisor});
+  _revision++;
+  _layoutRevision++;
+}
+
+void Geometry::setInstances(Instances instances) {
+  _instances.push_back(std::move(instances));
+  _revision++;
+  _layoutRevision++;
+}
+
+Geometry::Attribute &Geometry::getAttribute(const std::string name) {
+  // the caller may swap the buffer or edit the format, rebind it on next draw
+  _revision++;
+  _layoutRevision++;
+
+  return _attributes.at(name);
+}
+
+IndexVariant &Geometry::getIndex() {
+  _revision++;
+
+  return _index.value();
 }
 
 void Geometry::setRange(const Range range) {
   _range = range;
 }
 
-void Geometry::setRange(const uint16_t start, const uint16_t count) {
-  _range = {start, count};
+void Geometry::setRange(
+  const uint32_t start,
+  const uint32_t count,
+  const int32_t baseVertex
+) {
+  _range = {start, count, baseVertex};
 }
 
-void Geometry::draw(Program program) {
-  // create vertex array object if never drew program before
-  if (_ids.find(program.getId()) == _ids.end()) {
-    createVAO(program); 
-  }
+const Geometry::Range Geometry::getRange() const {
+  return _range;
+}
+
+void Geometry::setBounds(const Bounds bounds) {
+  _bounds = bounds;
+}
+
+const std::optional<Bounds> Geometry::getBounds() const {
+  return _bounds;
+}
+
+void Geometry::draw(
+  const Program &program,
+  const uint32_t instances,
+  const uint32_t baseInstance
+) {
+  bindVAO(program);
 
-  // draw arrays without index
+  // draw arrays without index, ignoring the base vertex
   if (!_index) {
-    glAssert(glDrawArrays(GL_TRIANGLES, _range.start, _range.count));
+    if (baseInstance) {
+      glAssert(glDrawArraysInstancedBaseInstance(
+        GL_TRIANGLES, _range.start, _range.count, instances, baseInstance
+      ));
+    } else {
+      glAssert(glDrawArraysInstanced(
+        GL_TRIANGLES, _range.start, _range.count, instances
+      ));
+    }
   } else {
-    // retrieve & bind the index buffer
-    IndexBuffer &index = _index.value();
-    index.bind();
+    // generate a draw elements lambda for any index width
+    const auto drawElements = [&](auto &&index) -> void {
+      typedef typename std::remove_cvref_t<decltype(index)>::Value Value;
+
+      // bind the index buffer unless attached to the vertex array
+      if (!hasDirectStateAccess()) index.bind();
 
-    // draw our geometry elements
-    glAssert(
-      glDrawElements(GL_TRIANGLES, index.getSize(), index.getType(), nullptr)
-    );
+      // the range selects a sub-mesh of a shared index & vertex buffer
+      const uintptr_t offset = index.getOffset() + _range.start * sizeof(Value);
+
+      if (baseInstance) {
+        glAssert(glDrawElementsInstancedBaseVertexBaseInstance(
+          GL_TRIANGLES,
+          _range.count,
+          index.getType(),
+          (void *)offset,
+          instances,
+          _range.baseVertex,
+          baseInstance
+        ));
+      } else {
+        glAssert(glDrawElementsInstancedBaseVertex(
+          GL_TRIANGLES,
+          _range.count,
+          index.getType(),
+          (void *)offset,
+          instances,
+          _range.baseVertex
+        ));
+      }
+    };
+
+    // visit index buffer & draw
+    std::visit(drawElements, _index.value());
   }
 }
 
+void Geometry::drawIndirect(
+  const Program &program,
+  const uint32_t buffer,
+  const uint32_t count,
+  const uint32_t offset
+) {
+  // commands are laid out for indexed draws only
+  if (!_index) throw IndirectDrawError();
+
+  bindVAO(program);
+
+  const uint32_t type = bindIndex();
+
+  glAssert(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, buffer));
+  glAssert(glMultiDrawElementsIndirect(
+    GL_TRIANGLES,
+    type,
+    (void *)(uintptr_t)offset,
+    count,
+    sizeof(DrawCommand)
+  ));
+}
+
+void Geometry::drawIndirectCount(
+  const Program &program,
+  const uint32_t buffer,
+  const uint32_t parameter,
+  const uint32_t maxCount,
+  const uint32_t offset,
+  const uint32_t parameterOffset
+) {
+  // commands are laid out for indexed draws only
+  if (!_index) throw IndirectDrawError();
+
+  bindVAO(program);
+
+  const uint32_t type = bindIndex();
+
+  glAssert(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, buffer));
+  glAssert(glBindBuffer(GL_PARAMETER_BUFFER, parameter));
+  glAssert(glMultiDrawElementsIndirectCount(
+    GL_TRIANGLES,
+    type,
+    (void *)(uintptr_t)offset,
+    parameterOffset,
+    maxCount,
+    sizeof(DrawCommand)
+  ));
+}
+
+std::optional<DrawCommand> Geometry::getIndirectCommand(
+  const Geometry &base,
+  const uint32_t instances,
+  const uint32_t baseInstance
+) const {
+  if (!_index || !base._index) return {};
+
+  // both geometries must read the same index buffer & width
+  const auto getIndex = [](auto &&index) {
+    typedef typename std::remove_cvref_t<decltype(index)>::Value Value;
+    return std::tuple(index.getId(), index.getOffset(), sizeof(Value));
+  };
+
+  const auto [id, offset, size] = std::visit(getIndex, *_index);
+  const auto other = std::visit(getIndex, *base._index);
+
+  if (id != std::get<0>(other) || size != std::get<2>(other)) return {};
+  if (offset % size) return {};
+
+  // vertices must come from the same buffers, shifted by a whole vertex count
+  const std::vector<Binding> bindings = getBindings();
+  const std::vector<Binding> baseBindings = base.getBindings();
+  if (bindings.size() != baseBindings.size()) return {};
+
+  std::optional<int64_t> shift;
+
+  for (size_t i = 0; i < bindings.size(); i++) {
+    const Binding &binding = bindings[i];
+    const Binding &other = baseBindings[i];
+
+    if (binding.buffer != other.buffer || binding.stride != other.stride) {
+      return {};
+    }
+
+    if (binding.divisor != other.divisor || binding.stride <= 0) return {};
+
+    // per-instance values are selected through the base instance only
+    const int64_t bytes = (int64_t)binding.offset - other.offset;
+    if (binding.divisor && bytes) return {};
+    if (binding.divisor) continue;
+
+    if (bytes % binding.stride) return {};
+    if (shift && *shift != bytes / binding.stride) return {};
+    shift = bytes / binding.stride;
+  }
+
+  return DrawCommand{
+    .count = _range.count,
+    .instanceCount = instances,
+    .firstIndex = (uint32_t)(offset / size) + _range.start,
+    .baseVertex = (int32_t)shift.value_or(0) + _range.baseVertex,
+    .baseInstance = baseInstance,
+  };
+}
+
 void Geometry::destroy() {
-  // iterate and destroy buffer attributes
-  for (auto attribute : _attributes) {
-    std::visit(
-      [](auto &&buffer) { buffer.destroy(); },
-      static_cast<BufferVariant>(attribute.second.buffer)
-    );
+  // buffer attributes & index release themselves
+  _attributes.clear();
+  _interleaved.clear();
+  _instances.clear();
+  _index.reset();
+
+  // iterate and destroy vertex arrays, deferred while frames are in flight
+  DeletionQueue *queue = DeletionQueue::getCurrent();
+
+  for (const auto &[format, vertexArray] : _vertexArrays) {
+    if (queue) {
+      queue->deleteVertexArray(vertexArray.id);
+    } else {
+      glAssert(glDeleteVertexArrays(1, &vertexArray.id));
+    }
+  }
+
+  _vertexArrays.clear();
+  _programs.clear();
+}
+
+void Geometry::flush() {
+  // iterate and flush buffer attributes
+  for (auto &pair : _attributes) {
+    std::visit([](auto &&buffer) { buffer.flush(); }, pair.second.buffer);
   }
 
-  // iterate and destroy vertex arrays
-  for (uint32_t i = 0; i < _ids.size(); i++) {
-    glAssert(glDeleteVertexArrays(1, &_ids[i]));
+  for (Interleaved &interleaved : _interleaved) {
+    interleaved.buffer.flush();
+  }
+
+  if (_index) {
+    std::visit([](auto &&index) { index.flush(); }, _index.value());
   }
 }
 
-void Geometry::createVAO(Program program) {
-  // generate empty id at program location
-  _ids.insert({program.getId(), 0});
-  uint32_t *id = &_ids[program.getId()];
+void Geometry::bindVAO(const Program &program) {
+  // upload pending buffer updates before reading them
+  flush();
 
-  // create & bind the vertex array
-  glAssert(glGenVertexArrays(1, id));
-  glAssert(glBindVertexArray(*id));
+  // a changed attribute set may change every program' vertex format
+  if (_programsRevision != _layoutRevision) {
+    _programs.clear();
+    _programsRevision = _layoutRevision;
+  }
 
-  // iterate program' active attributes
-  for (const auto pair : program.getAttributes()) {
-    const std::string name = pair.first;
-    const uint32_t location = pair.second.location;
+  // find the vertex array matching the program' vertex format
+  auto iterator = _programs.find(program.getId());
+  if (iterator == _programs.end()) {
+    const auto [entry, created] =
+      _vertexArrays.try_emplace(getFormat(program), VertexArray());
 
-    // attempt to find a corresponding geometry attribute
-    const auto iterator = _attributes.find(name);
-    if (iterator == _attributes.end()) continue;
+    if (created) createVAO(entry->second, program);
 
-    // retrieve the geometry attribute size & buffer
-    const Attribute &attribute = iterator->second;
-    const BufferVariant &buffer = iterator->second.buffer;
+    iterator = _programs.emplace(program.getId(), &entry->second).first;
+  }
 
-    // generate a bind attribute lamba
-    const auto bindAttribute = [location, attribute](auto &&buffer) -> void {
-      buffer.bind();
+  VertexArray &vertexArray = *iterator->second;
+  const uint64_t generation = BufferArena::getGeneration();
 
-      // vertex attribute to our currently bound buffer
-      glAssert(glEnableVertexAttribArray(location));
-      glAssert(glVertexAttribPointer(
-        location,
-        attribute.size,
-        buffer.getType(),
-        attribute.normalized,
-        attribute.stride,
-        (void *)attribute.offset
-      ));
+  // swapped & defragmented buffers of an unchanged format are rebound
+  // keeping the attribute formats
+  if (vertexArray.revision != _revision ||
+      vertexArray.generation != generation) {
+    setupVAO(vertexArray.id, program, false);
+    vertexArray.revision = _revision;
+    vertexArray.generation = generation;
+  }
+
+  glAssert(glBindVertexArray(vertexArray.id));
+}
+
+Geometry::Format Geometry::getFormat(const Program &program) const {
+  const auto &attributes = program.getAttributes();
+  Format format = {_index.has_value()};
+
+  // record how each active attribute is read, leaving buffers out
+  for (const Binding &binding : getBindings()) {
+    format.push_back(binding.stride);
+    format.push_back(binding.divisor);
+
+    for (const VertexLayout::Element &element : binding.layout.getElements()) {
+      const auto iterator = attributes.find(element.name);
+      if (iterator == attributes.end()) continue;
+
+      format.push_back(iterator->second.location);
+      format.push_back(element.size);
+      format.push_back(element.type);
+      format.push_back(element.normalized);
+      format.push_back(element.offset);
+    }
+  }
+
+  return format;
+}
+
+std::vector<Geometry::Binding> Geometry::getBindings() const {
+  std::vector<Binding> bindings;
+
+  // attributes are unordered, sort them to compare formats & geometries
+  const std::map<std::string, const Attribute *> attributes = [this] {
+    std::map<std::string, const Attribute *> sorted;
+    for (const auto &[name, attribute] : _attributes) {
+      sorted[name] = &attribute;
+    }
+    return sorted;
+  }();
+
+  for (const auto &[name, attribute] : attributes) {
+    const auto getBinding = [&](auto &&buffer) -> Binding {
+      typedef typename std::remove_cvref_t<decltype(buffer)>::Value Value;
+      typedef GLTypeTraits<Value> Traits;
+
+      // separate buffers use an explicit stride for tightly packed data
+      const int32_t tight =
+        Traits::packed ? sizeof(Value) : attribute->size * sizeof(Value);
+
+      // normalized value types are always read as normalized
+      VertexLayout layout({{
+        .name = name,
+        .size = attribute->size,
+        .type = buffer.getType(),
+        .normalized = attribute->normalized || Traits::normalized,
+      }});
+
+      return {
+        std::move(layout),
+        buffer.getId(),
+        (uint32_t)(attribute->offset + buffer.getOffset()),
+        attribute->stride ? attribute->stride : tight,
+        attribute->divisor,
+      };
     };
 
-    // visit buffer & bind it to attribute
-    std::visit(bindAttribute, buffer);
+    bindings.push_back(std::visit(getBinding, attribute->buffer));
+  }
+
+  for (const Interleaved &interleaved : _interleaved) {
+    bindings.push_back({
+      interleaved.layout,
+      interleaved.buffer.getId(),
+      interleaved.buffer.getOffset(),
+      (int32_t)interleaved.layout.getStride(),
+      interleaved.divisor,
+    });
+  }
+
+  // instance buffers owned elsewhere are read from their first byte
+  for (const Instances &instances : _instances) {
+    bindings.push_back({
+      instances.layout,
+      instances.buffer,
+      0,
+      (int32_t)instances.layout.getStride(),
+      instances.divisor,
+    });
+  }
+
+  return bindings;
+}
+
+const uint32_t Geometry::bindIndex() const {
+  const auto bind = [](auto &&index) -> uint32_t {
+    // the index buffer is attached to the vertex array with direct state access
+    if (!hasDirectStateAccess()) index.bind();
+
+    return index.getType();
+  };
+
+  return std::visit(bind, *_index);
+}
+
+const uint32_t Geometry::getIndexId() const {
+  return std::visit([](auto &&index) { return index.getId(); }, *_index);
+}
+
+void Geometry::createVAO(VertexArray &vertexArray, const Program &program) {
+  // create the vertex array, binding happens while setting it up
+  if (hasDirectStateAccess()) {
+    glAssert(glCreateVertexArrays(1, &vertexArray.id));
+  } else {
+    glAssert(glGenVertexArrays(1, &vertexArray.id));
+  }
+
+  setupVAO(vertexArray.id, program, true);
+  vertexArray.revision = _revision;
+  vertexArray.generation = BufferArena::getGeneration();
+}
+
+void Geometry::setupVAO(
+  const uint32_t id,
+  const Program &program,
+  const bool formats
+) const {
+  // without direct state access the vertex array is edited while bound
+  if (hasDirectStateAccess()) {
+    if (_index) glAssert(glVertexArrayElementBuffer(id, getIndexId()));
+  } else {
+    glAssert(glBindVertexArray(id));
+  }
+
+  // bind every buffer once & point its elements into it
+  for (const Binding &binding : getBindings()) {
+    bindLayout(id, program, binding, formats);
+  }
+}
+
+void Geometry::bindLayout(
+  const uint32_t id,
+  const Program &program,
+  const Binding &binding,
+  const bool formats
+) const {
+  const bool dsa = hasDirectStateAccess();
+  const auto &attributes = program.getAttributes();
+
+  // the first active element location doubles as the shared binding index
+  int32_t index = -1;
+
+  if (!dsa) glAssert(glBindBuffer(GL_ARRAY_BUFFER, binding.buffer));
+
+  for (const VertexLayout::Element &element : binding.layout.getElements()) {
+    const auto iterator = attributes.find(element.name);
+    if (iterator == attributes.end()) continue;
+
+    const uint32_t location = iterator->second.location;
+
+    // swapping buffers only touches the binding with direct state access
+    if (dsa && index < 0) {
+      index = location;
+      glAssert(glVertexArrayVertexBuffer(
+        id, index, binding.buffer, binding.offset, binding.stride
+      ));
+      glAssert(glVertexArrayBindingDivisor(id, index, binding.divisor));
+    }
+
+    if (dsa && !formats) return;
+
+    // matrices span one location per tightly packed column
+    const int32_t rows = getColumnHeight(element.size);
+    const int32_t columns = (element.size + rows - 1) / rows;
+    const uint32_t columnSize =
+      VertexLayout::getSize({.size = rows, .type = element.type});
+
+    for (int32_t column = 0; column < columns; column++) {
+      const uint32_t attribute = location + column;
+      const int32_t size = std::min(element.size - column * rows, rows);
+      const uint32_t relative = element.offset + column * columnSize;
+
+      if (dsa) {
+        glAssert(glVertexArrayAttribFormat(
+          id, attribute, size, element.type, element.normalized, relative
+        ));
+        glAssert(glVertexArrayAttribBinding(id, attribute, index));
+        glAssert(glEnableVertexArrayAttrib(id, attribute));
+        continue;
+      }
+
+      glAssert(glEnableVertexAttribArray(attribute));
+      glAssert(glVertexAttribPointer(
+        attribute,
+        size,
+        element.type,
+        element.normalized,
+        binding.stride,
+        (void *)(uintptr_t)(binding.offset + relative)
+      ));
+      glAssert(glVertexAttribDivisor(attribute, binding.divisor));
+    }
   }
 }
 
@@ -0,0 +1,362 @@
+#include <cstring>
+#include <fstream>
+#include <utility>
+#include <algorithm>
+
+#include <stem/GeometryFile.hpp>
+
+namespace stem {
+
+namespace {
+
+/// @brief The alignment of every file section
+constexpr uint64_t SECTION_ALIGNMENT = 16;
+
+/// @brief Rounds a byte offset up to the next section boundary
+/// @param offset The byte offset to align
+/// @return The aligned byte offset
+uint64_t alignSection(const uint64_t offset) {
+  return (offset + SECTION_ALIGNMENT - 1) & ~(SECTION_ALIGNMENT - 1);
+}
+
+/// @brief Returns the byte size of a single index of a gl type
+/// @param type The gl index type
+/// @return The byte size or zero for unknown types
+uint32_t getIndexSize(const uint32_t type) {
+  switch (type) {
+  case GL_UNSIGNED_BYTE: return 1;
+  case GL_UNSIGNED_SHORT: return 2;
+  case GL_UNSIGNED_INT: return 4;
+  default: return 0;
+  }
+}
+
+/// @brief Returns whether a gl type can describe a vertex element
+/// @param type The gl data type
+/// @return Whether the type is a vertex element type
+bool isElementType(const uint32_t type) {
+  switch (type) {
+  case GL_BYTE:
+  case GL_UNSIGNED_BYTE:
+  case GL_SHORT:
+  case GL_UNSIGNED_SHORT:
+  case GL_INT:
+  case GL_UNSIGNED_INT:
+  case GL_HALF_FLOAT:
+  case GL_FLOAT:
+  case GL_DOUBLE:
+  case GL_INT_2_10_10_10_REV:
+  case GL_UNSIGNED_INT_2_10_10_10_REV:
+  case GL_UNSIGNED_INT_10F_11F_11F_REV: return true;
+  default: return false;
+  }
+}
+
+/// @brief Writes values & pads the stream up to a byte offset
+/// @param stream The stream to write to
+/// @param offset The byte offset the values start at
+/// @param data The values' bytes
+/// @param size The number of bytes to write
+/// @return void
+void writeSection(
+  std::ofstream &stream,
+  const uint64_t offset,
+  const void *data,
+  const uint64_t size
+) {
+  const std::vector<char> padding(offset - (uint64_t)stream.tellp(), 0);
+  stream.write(padding.data(), padding.size());
+  stream.write((const char *)data, size);
+}
+
+/// @brief Maps a geometry file, reporting failures as geometry file errors
+/// @param path The file' path
+/// @return The mapped file
+MappedFile mapFile(const std::string &path) {
+  try {
+    return MappedFile(path);
+  } catch (const MappedFileError &) {
+    throw GeometryFileError(path, "can not be opened");
+  }
+}
+
+} // namespace
+
+GeometryFileError::GeometryFileError(
+  const std::string path,
+  const std::string reason
+) {
+  _message = "Geometry file " + path + " " + reason;
+}
+
+GeometryFile::GeometryFile(const std::string path) :
+  _path(path), _file(mapFile(path)) {
+  validate(path);
+}
+
+GeometryFile::GeometryFile(GeometryFile &&other) noexcept :
+  _path(std::move(other._path)),
+  _file(std::move(other._file)),
+  _header(other._header) {}
+
+GeometryFile &GeometryFile::operator=(GeometryFile &&other) noexcept {
+  if (this == &other) return *this;
+
+  _path = std::move(other._path);
+  _file = std::move(other._file);
+  _header = other._header;
+
+  return *this;
+}
+
+GeometryFile::~GeometryFile() {
+  destroy();
+}
+
+void GeometryFile::validate(const std::string &path) {
+  const std::span<const uint8_t> data = _file.getData();
+
+  if (data.size() < sizeof(GeometryFileHeader)) {
+    throw GeometryFileError(path, "is truncated");
+  }
+
+  std::memcpy(&_header, data.data(), sizeof(_header));
+
+  if (std::memcmp(_header.magic, GeometryFileHeader().magic, 8)) {
+    throw GeometryFileError(path, "is not a .stemgeo file");
+  }
+
+  if (_header.version != GeometryFileHeader().version) {
+    const std::string version = std::to_string(_header.version);
+    throw GeometryFileError(path, "has unsupported version " + version);
+  }
+
+  // sections must be aligned for their values to be read in place
+  const uint64_t offsets[] = {
+    _header.elementsOffset, _header.verticesOffset, _header.indicesOffset
+  };
+
+  const uint64_t sizes[] = {
+    (uint64_t)_header.elementCount * sizeof(GeometryFileElement),
+    (uint64_t)_header.vertexCount * _header.stride,
+    (uint64_t)_header.indexCount * getIndexSize(_header.indexType),
+  };
+
+  for (uint32_t section = 0; section < 3; section++) {
+    if (offsets[section] % SECTION_ALIGNMENT) {
+      throw GeometryFileError(path, "has a misaligned section");
+    }
+
+    const uint64_t size = data.size();
+    if (offsets[section] > size || sizes[section] > size - offsets[section]) {
+      throw GeometryFileError(path, "is truncated");
+    }
+  }
+
+  if (_header.indexCount && !getIndexSize(_header.indexType)) {
+    throw GeometryFileError(path, "has an unknown index type");
+  }
+
+  // element records must describe the vertices the stride steps over
+  std::vector<GeometryFileElement> records(_header.elementCount);
+  std::memcpy(records.data(), data.data() + _header.elementsOffset, sizes[0]);
+
+  for (const GeometryFileElement &record : records) {
+    if (!isElementType(record.type)) {
+      throw GeometryFileError(path, "has an unknown element type");
+    }
+
+    if (record.size < 1 || record.size > 16) {
+      throw GeometryFileError(path, "has an invalid element size");
+    }
+  }
+
+  const VertexLayout layout = getLayout();
+  const std::vector<VertexLayout::Element> &elements = layout.getElements();
+
+  for (size_t index = 0; index < records.size(); index++) {
+    if (records[index].offset != elements[index].offset) {
+      throw GeometryFileError(path, "has a misplaced element");
+    }
+  }
+
+  if (layout.getStride() != _header.stride) {
+    throw GeometryFileError(path, "has a stride not matching its elements");
+  }
+}
+
+Geometry GeometryFile::createGeometry(const uint32_t usage) const {
+  // gl buffer sizes are 32-bit, larger sections can only be read in parts
+  const uint64_t limit = UINT32_MAX;
+  if (getVertices().size() > limit || getIndices().size() > limit) {
+    throw GeometryFileError(_path, "has sections too large for a gl buffer");
+  }
+
+  Geometry geometry;
+  const VertexLayout layout = getLayout();
+
+  // upload the mapped bytes as they are, without conversion
+  geometry.setInterleaved(
+    layout, Uint8Buffer(getVertices(), (Uint8Buffer::Usage)usage)
+  );
+
+  const std::byte *indices = getIndices().data();
+  const uint32_t count = _header.indexCount;
+
+  switch (count ? _header.indexType : GL_NONE) {
+  case GL_UNSIGNED_BYTE:
+    geometry.setIndex(Index8Buffer(
+      std::span((const uint8_t *)indices, count), (Index8Buffer::Usage)usage
+    ));
+    break;
+  case GL_UNSIGNED_SHORT:
+    geometry.setIndex(Index16Buffer(
+      std::span((const uint16_t *)indices, count), (Index16Buffer::Usage)usage
+    ));
+    break;
+  case GL_UNSIGNED_INT:
+    geometry.setIndex(IndexBuffer(
+      std::span((const uint32_t *)indices, count), (IndexBuffer::Usage)usage
+    ));
+    break;
+  }
+
+  // geometries without computed bounds are never culled
+  if (_header.bounded) geometry.setBounds(_header.bounds);
+
+  return geometry;
+}
+
+VertexLayout GeometryFile::getLayout() const {
+  std::vector<VertexLayout::Element> elements;
+  const uint8_t *records = _file.getData().data() + _header.elementsOffset;
+
+  for (uint32_t index = 0; index < _header.elementCount; index++) {
+    GeometryFileElement record;
+    std::memcpy(&record, records + index * sizeof(record), sizeof(record));
+
+    // guard against names missing their null terminator
+    const std::string name(record.name, strnlen(record.name, 48));
+    elements.push_back({name, record.size, record.type, !!record.normalized});
+  }
+
+  return VertexLayout(std::move(elements));
+}
+
+const std::span<const uint8_t> GeometryFile::getVertices() const {
+  const uint8_t *data = _file.getData().data();
+  const size_t size = (size_t)_header.vertexCount * _header.stride;
+
+  return {data + _header.verticesOffset, size};
+}
+
+const std::span<const std::byte> GeometryFile::getIndices() const {
+  const size_t size =
+    (size_t)_header.indexCount * getIndexSize(_header.indexType);
+
+  const std::byte *data = (const std::byte *)_file.getData().data();
+
+  return {data + _header.indicesOffset, size};
+}
+
+const GeometryFileHeader &GeometryFile::getHeader() const {
+  return _header;
+}
+
+void GeometryFile::destroy() {
+  _file.destroy();
+  _header = {};
+}
+
+void writeGeometryFile(
+  const std::string path,
+  const VertexLayout &layout,
+  const std::span<const uint8_t> vertices,
+  const std::span<const uint32_t> indices
+) {
+  GeometryFileHeader header;
+  const std::vector<VertexLayout::Element> &elements = layout.getElements();
+
+  header.elementCount = elements.size();
+  header.stride = layout.getStride();
+  header.vertexCount = header.stride ? vertices.size() / header.stride : 0;
+
+  // describe the elements with fixed size records
+  std::vector<GeometryFileElement> records(elements.size());
+
+  for (size_t index = 0; index < elements.size(); index++) {
+    const VertexLayout::Element &element = elements[index];
+    GeometryFileElement &record = records[index];
+
+    if (element.name.size() >= sizeof(record.name)) {
+      throw GeometryFileError(path, "has a too long element " + element.name);
+    }
+
+    std::memcpy(record.name, element.name.data(), element.name.size());
+    record.size = element.size;
+    record.type = element.type;
+    record.normalized = element.normalized;
+    record.offset = element.offset;
+
+    // bound the float positions, read with the vertex stride
+    const bool positions = element.name == "position" &&
+                           element.type == GL_FLOAT && element.size >= 3;
+
+    if (positions && header.vertexCount) {
+      const size_t size =
+        (size_t)header.vertexCount * header.stride - element.offset;
+      const float *first = (const float *)(vertices.data() + element.offset);
+      header.bounds = computeBounds(
+        std::span(first, size / sizeof(float)), header.stride / sizeof(float)
+      );
+      header.bounded = 1;
+    }
+  }
+
+  // narrow indices as createIndexBuffer does
+  uint32_t maxIndex = 0;
+  for (const uint32_t index : indices) {
+    maxIndex = std::max(maxIndex, index);
+  }
+
+  header.indexCount = indices.size();
+  header.indexType = indices.empty() ? GL_NONE : selectIndexType(maxIndex);
+
+  const uint32_t indexSize = getIndexSize(header.indexType);
+  std::vector<uint8_t> bytes(indices.size() * indexSize);
+
+  // little-endian values keep their low bytes first
+  for (size_t index = 0; index < indices.size(); index++) {
+    std::memcpy(&bytes[index * indexSize], &indices[index], indexSize);
+  }
+
+  // lay sections out one after another on aligned offsets
+  header.elementsOffset = alignSection(sizeof(header));
+  header.verticesOffset =
+    alignSection(header.elementsOffset + records.size() * sizeof(records[0]));
+  header.indicesOffset = alignSection(
+    header.verticesOffset + (uint64_t)header.vertexCount * header.stride
+  );
+
+  std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+  if (!stream) throw GeometryFileError(path, "can not be written");
+
+  stream.write((const char *)&header, sizeof(header));
+  writeSection(
+    stream,
+    header.elementsOffset,
+    records.data(),
+    records.size() * sizeof(records[0])
+  );
+  writeSection(
+    stream,
+    header.verticesOffset,
+    vertices.data(),
+    (uint64_t)header.vertexCount * header.stride
+  );
+  writeSection(stream, header.indicesOffset, bytes.data(), bytes.size());
+
+  if (!stream) throw GeometryFileError(path, "can not be written");
+}
+
+} // namespace stem
@@ -0,0 +1,86 @@
+#include <fstream>
+#include <utility>
+
+#include <stem/MappedFile.hpp>
+
+#if defined(__unix__) || defined(__APPLE__)
+  #define STEM_MMAP
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#endif
+
+namespace stem {
+
+MappedFileError::MappedFileError(
+  const std::string path,
+  const std::string reason
+) {
+  _message = "File " + path + " " + reason;
+}
+
+MappedFile::MappedFile(const std::string path) {
+#ifdef STEM_MMAP
+  // map the whole file read-only, pages are loaded on first access
+  const int descriptor = open(path.c_str(), O_RDONLY);
+  if (descriptor < 0) throw MappedFileError(path, "can not be opened");
+
+  struct stat status;
+  if (fstat(descriptor, &status) == 0 && status.st_size > 0) {
+    _size = status.st_size;
+    void *data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    if (data != MAP_FAILED) _data = (const uint8_t *)data;
+  }
+
+  close(descriptor);
+  if (!_data) throw MappedFileError(path, "can not be mapped");
+#else
+  std::ifstream stream(path, std::ios::binary | std::ios::ate);
+  if (!stream) throw MappedFileError(path, "can not be opened");
+
+  _storage.resize(stream.tellg());
+  stream.seekg(0);
+  stream.read((char *)_storage.data(), _storage.size());
+
+  _data = _storage.data();
+  _size = _storage.size();
+#endif
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept {
+  *this = std::move(other);
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept {
+  if (this == &other) return *this;
+
+  // release our own mapping before taking the other one
+  destroy();
+
+  _data = std::exchange(other._data, nullptr);
+  _size = std::exchange(other._size, 0);
+  _storage = std::exchange(other._storage, {});
+
+  return *this;
+}
+
+MappedFile::~MappedFile() {
+  destroy();
+}
+
+const std::span<const uint8_t> MappedFile::getData() const {
+  return {_data, _size};
+}
+
+void MappedFile::destroy() {
+#ifdef STEM_MMAP
+  if (_data) munmap((void *)_data, _size);
+#endif
+
+  _data = nullptr;
+  _size = 0;
+  _storage.clear();
+}
+
+} // namespace stem
@@ -0,0 +1,313 @@
+#include <cmath>
+#include <numeric>
+#include <algorithm>
+
+#include <stem/MeshOptimizer.hpp>
+
+namespace stem {
+
+namespace {
+
+/// @brief Simulates a fifo vertex cache one triangle at a time
+class FifoCache {
+public:
+  /// @brief FifoCache constructor
+  /// @param vertexCount The number of vertices
+  /// @param cacheSize The number of cache entries
+  /// @return FifoCache
+  FifoCache(const uint32_t vertexCount, const uint32_t cacheSize) :
+    _size(cacheSize), _timestamps(vertexCount, 0), _time(cacheSize + 1) {}
+
+  /// @brief Feeds a triangle through the cache
+  /// @param triangle The three triangle indices
+  /// @return The number of cache misses
+  uint32_t feed(const uint32_t *triangle) {
+    uint32_t misses = 0;
+
+    for (uint32_t i = 0; i < 3; i++) {
+      const uint32_t vertex = triangle[i];
+      if (_time - _timestamps[vertex] <= _size) continue;
+
+      _timestamps[vertex] = _time++;
+      misses++;
+    }
+
+    return misses;
+  }
+
+private:
+  /// @brief The number of cache entries
+  uint32_t _size;
+
+  /// @brief The time every vertex entered the cache
+  std::vector<uint32_t> _timestamps;
+
+  /// @brief The current cache time
+  uint32_t _time;
+};
+
+} // namespace
+
+TriangleAdjacency::TriangleAdjacency(
+  const std::span<const uint32_t> indices,
+  const uint32_t vertexCount
+) :
+  offsets(vertexCount + 1, 0), triangles(indices.size()) {
+  for (const uint32_t index : indices) {
+    offsets[index + 1]++;
+  }
+
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  // fill rows using a moving cursor per vertex
+  std::vector<uint32_t> cursors(offsets.begin(), offsets.end() - 1);
+
+  for (size_t i = 0; i < indices.size(); i++) {
+    triangles[cursors[indices[i]]++] = i / 3;
+  }
+}
+
+VertexCacheStatistics analyzeVertexCache(
+  const std::span<const uint32_t> indices,
+  const uint32_t vertexCount,
+  const uint32_t cacheSize
+) {
+  VertexCacheStatistics statistics;
+  if (indices.size() < 3) return statistics;
+
+  FifoCache cache(vertexCount, cacheSize);
+  std::vector<bool> referenced(vertexCount, false);
+  uint32_t unique = 0;
+
+  for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+    statistics.transformed += cache.feed(&indices[i]);
+
+    for (size_t j = i; j < i + 3; j++) {
+      if (referenced[indices[j]]) continue;
+      referenced[indices[j]] = true;
+      unique++;
+    }
+  }
+
+  statistics.acmr = (float)statistics.transformed / (indices.size() / 3);
+  statistics.atvr = (float)statistics.transformed / unique;
+
+  return statistics;
+}
+
+void optimizeVertexCache(
+  const std::span<uint32_t> indices,
+  const uint32_t vertexCount,
+  const uint32_t cacheSize
+) {
+  const uint32_t triangleCount = indices.size() / 3;
+  if (!triangleCount || !vertexCount) return;
+
+  const TriangleAdjacency adjacency(
+    indices.first(triangleCount * 3), vertexCount
+  );
+
+  // count the triangles left to emit around every vertex
+  std::vector<uint32_t> live(vertexCount);
+  for (uint32_t vertex = 0; vertex < vertexCount; vertex++) {
+    live[vertex] = adjacency.offsets[vertex + 1] - adjacency.offsets[vertex];
+  }
+
+  std::vector<uint32_t> timestamps(vertexCount, 0);
+  std::vector<bool> emitted(triangleCount, false);
+  std::vector<uint32_t> deadEnd;
+  std::vector<uint32_t> candidates;
+  std::vector<uint32_t> output;
+  output.reserve(triangleCount * 3);
+
+  uint32_t time = cacheSize + 1;
+  uint32_t cursor = 0;
+  int64_t fanning = 0;
+
+  while (fanning >= 0) {
+    candidates.clear();
+
+    // emit every remaining triangle around the fanning vertex
+    const uint32_t first = adjacency.offsets[fanning];
+    const uint32_t last = adjacency.offsets[fanning + 1];
+
+    for (uint32_t i = first; i < last; i++) {
+      const uint32_t triangle = adjacency.triangles[i];
+      if (emitted[triangle]) continue;
+
+      for (uint32_t corner = 0; corner < 3; corner++) {
+        const uint32_t vertex = indices[triangle * 3 + corner];
+
+        output.push_back(vertex);
+        deadEnd.push_back(vertex);
+        candidates.push_back(vertex);
+        live[vertex]--;
+
+        if (time - timestamps[vertex] > cacheSize) timestamps[vertex] = time++;
+      }
+
+      emitted[triangle] = true;
+    }
+
+    // prefer the oldest candidate still in cache once its fan is emitted
+    fanning = -1;
+    int64_t priority = -1;
+
+    for (const uint32_t vertex : candidates) {
+      if (!live[vertex]) continue;
+
+      int64_t score = 0;
+      if (time - timestamps[vertex] + 2 * live[vertex] <= cacheSize) {
+        score = time - timestamps[vertex];
+      }
+
+      if (score > priority) {
+        priority = score;
+        fanning = vertex;
+      }
+    }
+
+    if (fanning >= 0) continue;
+
+    // fall back to recently used vertices, then to the next unused one
+    while (!deadEnd.empty() && fanning < 0) {
+      const uint32_t vertex = deadEnd.back();
+      deadEnd.pop_back();
+      if (live[vertex]) fanning = vertex;
+    }
+
+    while (cursor < vertexCount && fanning < 0) {
+      if (live[cursor]) fanning = cursor;
+      cursor++;
+    }
+  }
+
+  std::copy(output.begin(), output.end(), indices.begin());
+}
+
+void optimizeOverdraw(
+  const std::span<uint32_t> indices,
+  const std::span<const float> positions,
+  const uint32_t stride,
+  const uint32_t cacheSize,
+  const float threshold
+) {
+  const uint32_t triangleCount = indices.size() / 3;
+  const uint32_t vertexCount = positions.size() / stride;
+  if (triangleCount < 2 || !vertexCount) return;
+
+  const float acmr =
+    analyzeVertexCache(indices, vertexCount, cacheSize).acmr;
+
+  // split clusters on cold caches & where their acmr is close to the mesh'
+  std::vector<uint32_t> clusters = {0};
+  FifoCache cache(vertexCount, cacheSize);
+  uint32_t misses = 0;
+
+  for (uint32_t triangle = 0; triangle < triangleCount; triangle++) {
+    const uint32_t triangleMisses = cache.feed(&indices[triangle * 3]);
+
+    if (triangleMisses == 3 && triangle > clusters.back()) {
+      clusters.push_back(triangle);
+      misses = 0;
+    }
+
+    misses += triangleMisses;
+
+    const uint32_t size = triangle + 1 - clusters.back();
+    if ((float)misses / size <= threshold * acmr) {
+      clusters.push_back(triangle + 1);
+      misses = 0;
+    }
+  }
+
+  if (clusters.back() != triangleCount) clusters.push_back(triangleCount);
+
+  // find the mesh centroid
+  float center[3] = {0, 0, 0};
+  for (uint32_t vertex = 0; vertex < vertexCount; vertex++) {
+    for (uint32_t axis = 0; axis < 3; axis++) {
+      center[axis] += positions[vertex * stride + axis] / vertexCount;
+    }
+  }
+
+  // sort clusters by how much they face away from the mesh centroid
+  const uint32_t clusterCount = clusters.size() - 1;
+  std::vector<float> keys(clusterCount);
+
+  for (uint32_t cluster = 0; cluster < clusterCount; cluster++) {
+    float centroid[3] = {0, 0, 0};
+    float normal[3] = {0, 0, 0};
+    float area = 0;
+
+    for (uint32_t t = clusters[cluster]; t < clusters[cluster + 1]; t++) {
+      const float *a = &positions[indices[t * 3 + 0] * stride];
+      const float *b = &positions[indices[t * 3 + 1] * stride];
+      const float *c = &positions[indices[t * 3 + 2] * stride];
+
+      const float u[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+      const float v[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+      const float n[3] = {
+        u[1] * v[2] - u[2] * v[1],
+        u[2] * v[0] - u[0] * v[2],
+        u[0] * v[1] - u[1] * v[0],
+      };
+
+      // weight centroids by twice the triangle area, the cross length
+      const float weight = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+      for (uint32_t axis = 0; axis < 3; axis++) {
+        centroid[axis] += (a[axis] + b[axis] + c[axis]) / 3 * weight;
+        normal[axis] += n[axis];
+      }
+
+      area += weight;
+    }
+
+    if (area <= 0) continue;
+
+    float key = 0;
+    for (uint32_t axis = 0; axis < 3; axis++) {
+      key += (centroid[axis] / area - center[axis]) * normal[axis];
+    }
+
+    keys[cluster] = key / area;
+  }
+
+  std::vector<uint32_t> order(clusterCount);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+    return keys[a] > keys[b];
+  });
+
+  // write the clusters back in sorted order
+  std::vector<uint32_t> output;
+  output.reserve(triangleCount * 3);
+
+  for (const uint32_t cluster : order) {
+    output.insert(
+      output.end(),
+      indices.begin() + clusters[cluster] * 3,
+      indices.begin() + clusters[cluster + 1] * 3
+    );
+  }
+
+  std::copy(output.begin(), output.end(), indices.begin());
+}
+
+std::vector<uint32_t> optimizeVertexFetch(
+  const std::span<uint32_t> indices,
+  const uint32_t vertexCount
+) {
+  std::vector<uint32_t> remap(vertexCount, UINT32_MAX);
+  uint32_t next = 0;
+
+  for (uint32_t &index : indices) {
+    if (remap[index] == UINT32_MAX) remap[index] = next++;
+    index = remap[index];
+  }
+
+  return remap;
+}
+
+} // namespace stem
@@ -0,0 +1,355 @@
+#include <cmath>
+#include <numeric>
+#include <algorithm>
+
+#include <stem/MeshOptimizer.hpp>
+#include <stem/MeshSimplifier.hpp>
+
+namespace stem {
+
+namespace {
+
+/// @brief Stores the sum of squared distances to a set of weighted planes
+struct Quadric {
+  /// @brief The symmetric matrix terms
+  double a00 = 0, a11 = 0, a22 = 0, a10 = 0, a20 = 0, a21 = 0;
+
+  /// @brief The linear terms
+  double b0 = 0, b1 = 0, b2 = 0;
+
+  /// @brief The constant term
+  double c = 0;
+
+  /// @brief The total weight of the planes
+  double weight = 0;
+
+  /// @brief Accumulates the planes of another quadric
+  /// @param other The quadric to accumulate
+  /// @return void
+  void add(const Quadric &other) {
+    a00 += other.a00, a11 += other.a11, a22 += other.a22;
+    a10 += other.a10, a20 += other.a20, a21 += other.a21;
+    b0 += other.b0, b1 += other.b1, b2 += other.b2;
+    c += other.c, weight += other.weight;
+  }
+
+  /// @brief Returns the mean squared distance of a point to the planes
+  /// @param p The xyz point
+  /// @return The mean squared distance
+  double evaluate(const float *p) const {
+    const double x = p[0], y = p[1], z = p[2];
+    const double distance =
+      a00 * x * x + a11 * y * y + a22 * z * z +
+      2 * (a10 * x * y + a20 * x * z + a21 * y * z) +
+      2 * (b0 * x + b1 * y + b2 * z) + c;
+
+    return weight > 0 ? std::max(distance, 0.) / weight : 0;
+  }
+};
+
+/// @brief Defines a candidate edge collapse
+struct Collapse {
+  /// @brief The vertex removed by the collapse
+  uint32_t source;
+
+  /// @brief The vertex the source is merged onto
+  uint32_t target;
+
+  /// @brief The squared error of the collapse
+  double cost;
+};
+
+/// @brief Computes the unnormalized normal of a triangle
+/// @param a The first xyz corner
+/// @param b The second xyz corner
+/// @param c The third xyz corner
+/// @param normal The normal to write, twice the triangle area long
+/// @return void
+void getNormal(const float *a, const float *b, const float *c, float *normal) {
+  const float u[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+  const float v[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+
+  normal[0] = u[1] * v[2] - u[2] * v[1];
+  normal[1] = u[2] * v[0] - u[0] * v[2];
+  normal[2] = u[0] * v[1] - u[1] * v[0];
+}
+
+/// @brief Packs an undirected edge into a sortable key
+/// @param a The first edge vertex
+/// @param b The second edge vertex
+/// @return The edge key, smallest vertex in the high bits
+uint64_t getEdgeKey(const uint32_t a, const uint32_t b) {
+  return (uint64_t)std::min(a, b) << 32 | std::max(a, b);
+}
+
+/// @brief Collects the sorted edge keys of triangle indices, with repeats
+/// @param indices The triangle indices
+/// @return The edge keys, once per triangle using them
+std::vector<uint64_t> getEdges(const std::span<const uint32_t> indices) {
+  std::vector<uint64_t> edges;
+  edges.reserve(indices.size());
+
+  for (size_t i = 0; i < indices.size(); i += 3) {
+    edges.push_back(getEdgeKey(indices[i], indices[i + 1]));
+    edges.push_back(getEdgeKey(indices[i + 1], indices[i + 2]));
+    edges.push_back(getEdgeKey(indices[i + 2], indices[i]));
+  }
+
+  std::sort(edges.begin(), edges.end());
+
+  return edges;
+}
+
+} // namespace
+
+Simplified simplify(
+  const std::span<const uint32_t> indices,
+  const std::span<const float> positions,
+  const SimplifySettings &settings
+) {
+  const uint32_t stride = settings.stride;
+  const uint32_t vertexCount = positions.size() / stride;
+  const auto getPosition = [&](uint32_t vertex) {
+    return &positions[vertex * stride];
+  };
+
+  Simplified simplified;
+  simplified.indices.assign(
+    indices.begin(), indices.begin() + indices.size() / 3 * 3
+  );
+
+  std::vector<uint32_t> &result = simplified.indices;
+  if (result.size() <= settings.targetCount || !vertexCount) {
+    return simplified;
+  }
+
+  // accumulate the area weighted planes around every vertex
+  std::vector<Quadric> quadrics(vertexCount);
+
+  for (size_t i = 0; i < result.size(); i += 3) {
+    const float *a = getPosition(result[i]);
+    const float *b = getPosition(result[i + 1]);
+    const float *c = getPosition(result[i + 2]);
+
+    float normal[3];
+    getNormal(a, b, c, normal);
+
+    const float length = std::sqrt(
+      normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]
+    );
+    if (length <= 0) continue;
+
+    const double x = normal[0] / length, y = normal[1] / length;
+    const double z = normal[2] / length, w = length / 2;
+    const double d = -(x * a[0] + y * a[1] + z * a[2]);
+
+    Quadric plane;
+    plane.a00 = x * x * w, plane.a11 = y * y * w, plane.a22 = z * z * w;
+    plane.a10 = x * y * w, plane.a20 = x * z * w, plane.a21 = y * z * w;
+    plane.b0 = x * d * w, plane.b1 = y * d * w, plane.b2 = z * d * w;
+    plane.c = d * d * w, plane.weight = w;
+
+    for (size_t j = i; j < i + 3; j++) quadrics[result[j]].add(plane);
+  }
+
+  // lock vertices of edges not shared by exactly two triangles
+  std::vector<bool> locked(vertexCount, false);
+
+  if (settings.lockBorder) {
+    const std::vector<uint64_t> edges = getEdges(result);
+
+    for (size_t i = 0, j = 0; i < edges.size(); i = j) {
+      while (j < edges.size() && edges[j] == edges[i]) j++;
+      if (j - i == 2) continue;
+
+      locked[edges[i] >> 32] = true;
+      locked[edges[i] & UINT32_MAX] = true;
+    }
+  }
+
+  // penalize collapses across attribute discontinuities
+  const auto getCost = [&](uint32_t source, uint32_t target) {
+    Quadric quadric = quadrics[source];
+    quadric.add(quadrics[target]);
+    double cost = quadric.evaluate(getPosition(target));
+
+    for (size_t i = 0; i < settings.weights.size(); i++) {
+      const double delta =
+        settings.attributes[source * settings.attributeStride + i] -
+        settings.attributes[target * settings.attributeStride + i];
+      cost += settings.weights[i] * delta * delta;
+    }
+
+    return cost;
+  };
+
+  const double maxCost = (double)settings.targetError * settings.targetError;
+  std::vector<Collapse> collapses;
+  std::vector<uint32_t> remap(vertexCount);
+  std::vector<bool> touched(vertexCount);
+  double error = 0;
+
+  while (result.size() > settings.targetCount) {
+    const TriangleAdjacency adjacency(result, vertexCount);
+
+    // pick the cheapest direction of every unique edge
+    std::vector<uint64_t> edges = getEdges(result);
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    collapses.clear();
+
+    for (const uint64_t edge : edges) {
+      const uint32_t a = edge >> 32, b = edge & UINT32_MAX;
+      if (locked[a] && locked[b]) continue;
+
+      const double costA = locked[a] ? INFINITY : getCost(a, b);
+      const double costB = locked[b] ? INFINITY : getCost(b, a);
+
+      if (costA <= costB) collapses.push_back({a, b, costA});
+      else collapses.push_back({b, a, costB});
+    }
+
+    std::sort(collapses.begin(), collapses.end(), [](auto &a, auto &b) {
+      return a.cost < b.cost;
+    });
+
+    // collapse the cheapest edges, each vertex neighborhood at most once
+    const uint32_t budget = (result.size() - settings.targetCount) / 3;
+    uint32_t removed = 0, collapsed = 0;
+
+    std::iota(remap.begin(), remap.end(), 0);
+    std::fill(touched.begin(), touched.end(), false);
+
+    for (const Collapse &collapse : collapses) {
+      if (collapse.cost > maxCost || removed >= budget) break;
+
+      const uint32_t source = collapse.source, target = collapse.target;
+      if (touched[source] || touched[target]) continue;
+
+      const uint32_t first = adjacency.offsets[source];
+      const uint32_t last = adjacency.offsets[source + 1];
+
+      // reject collapses flipping or flattening the remaining triangles
+      bool flips = false;
+
+      for (uint32_t i = first; i < last && !flips; i++) {
+        const uint32_t *triangle = &result[adjacency.triangles[i] * 3];
+        if (std::count(triangle, triangle + 3, target)) continue;
+
+        const float *corners[3], *moved[3];
+        for (uint32_t corner = 0; corner < 3; corner++) {
+          corners[corner] = getPosition(triangle[corner]);
+          moved[corner] = getPosition(
+            triangle[corner] == source ? target : triangle[corner]
+          );
+        }
+
+        float before[3], after[3];
+        getNormal(corners[0], corners[1], corners[2], before);
+        getNormal(moved[0], moved[1], moved[2], after);
+
+        flips = before[0] * after[0] + before[1] * after[1] +
+                  before[2] * after[2] <= 0;
+      }
+
+      if (flips) continue;
+
+      // freeze the neighborhood whose triangles now reference the target
+      for (uint32_t i = first; i < last; i++) {
+        const uint32_t *triangle = &result[adjacency.triangles[i] * 3];
+        if (std::count(triangle, triangle + 3, target)) removed++;
+
+        for (uint32_t corner = 0; corner < 3; corner++) {
+          touched[triangle[corner]] = true;
+        }
+      }
+
+      remap[source] = target;
+      quadrics[target].add(quadrics[source]);
+      error = std::max(error, collapse.cost);
+      collapsed++;
+    }
+
+    if (!collapsed) break;
+
+    // rewrite indices & drop the triangles collapsed into edges
+    size_t count = 0;
+
+    for (size_t i = 0; i < result.size(); i += 3) {
+      const uint32_t a = remap[result[i]];
+      const uint32_t b = remap[result[i + 1]];
+      const uint32_t c = remap[result[i + 2]];
+      if (a == b || b == c || c == a) continue;
+
+      result[count++] = a, result[count++] = b, result[count++] = c;
+    }
+
+    result.resize(count);
+  }
+
+  simplified.error = std::sqrt(error);
+
+  return simplified;
+}
+
+LodChain createLodChain(
+  const std::span<const uint32_t> indices,
+  const std::span<const float> positions,
+  SimplifySettings settings,
+  const uint32_t levels,
+  const float ratio
+) {
+  const uint32_t vertexCount = positions.size() / settings.stride;
+
+  LodChain chain;
+  chain.indices.assign(
+    indices.begin(), indices.begin() + indices.size() / 3 * 3
+  );
+  chain.levels.push_back({{0, (uint32_t)chain.indices.size()}, 0});
+
+  std::vector<uint32_t> current = chain.indices;
+  float error = 0;
+
+  for (uint32_t level = 1; level < levels; level++) {
+    settings.targetCount = (uint32_t)(current.size() / 3 * ratio) * 3;
+
+    // levels simplify the previous one, so their errors add up
+    Simplified simplified = simplify(current, positions, settings);
+    if (simplified.indices.empty()) break;
+    if (simplified.indices.size() >= current.size()) break;
+
+    error += simplified.error;
+    optimizeVertexCache(simplified.indices, vertexCount);
+
+    const uint32_t start = chain.indices.size();
+    const uint32_t count = simplified.indices.size();
+    chain.levels.push_back({{start, count}, error});
+    chain.indices.insert(
+      chain.indices.end(),
+      simplified.indices.begin(),
+      simplified.indices.end()
+    );
+
+    current = std::move(simplified.indices);
+  }
+
+  return chain;
+}
+
+uint32_t selectLod(
+  const std::span<const LevelOfDetail> levels,
+  const float distance,
+  const float projectionScale,
+  const float threshold
+) {
+  if (levels.empty() || distance <= 0) return 0;
+
+  // project every level error onto the screen, coarsest level first
+  for (uint32_t level = levels.size() - 1; level > 0; level--) {
+    const float pixels = levels[level].error * projectionScale / distance;
+    if (pixels <= threshold) return level;
+  }
+
+  return 0;
+}
+
+} // namespace stem
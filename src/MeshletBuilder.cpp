@@ -0,0 +1,227 @@
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+
+#include <stem/MeshOptimizer.hpp>
+#include <stem/MeshletBuilder.hpp>
+
+namespace stem {
+
+namespace {
+
+/// @brief Computes the culling bounds of a meshlet from its triangles
+/// @param meshlet The meshlet to bound
+/// @param indices The meshlet indices
+/// @param positions The vertex positions, xyz first in every vertex
+/// @param stride The number of floats between consecutive vertex positions
+/// @return void
+void computeBounds(
+  Meshlet &meshlet,
+  const std::span<const uint32_t> indices,
+  const std::span<const float> positions,
+  const uint32_t stride
+) {
+  // center the sphere on the bounding box
+  float min[3] = {FLT_MAX, FLT_MAX, FLT_MAX};
+  float max[3] = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+
+  for (const uint32_t index : indices) {
+    for (uint32_t axis = 0; axis < 3; axis++) {
+      min[axis] = std::min(min[axis], positions[index * stride + axis]);
+      max[axis] = std::max(max[axis], positions[index * stride + axis]);
+    }
+  }
+
+  float radius = 0;
+  for (uint32_t axis = 0; axis < 3; axis++) {
+    meshlet.center[axis] = (min[axis] + max[axis]) / 2;
+  }
+
+  for (const uint32_t index : indices) {
+    const float *p = &positions[index * stride];
+    const float x = p[0] - meshlet.center[0];
+    const float y = p[1] - meshlet.center[1];
+    const float z = p[2] - meshlet.center[2];
+    radius = std::max(radius, x * x + y * y + z * z);
+  }
+
+  meshlet.radius = std::sqrt(radius);
+
+  // average the unit normals & measure how far they spread
+  std::vector<float> normals;
+  float axis[3] = {0, 0, 0};
+
+  for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+    const float *a = &positions[indices[i] * stride];
+    const float *b = &positions[indices[i + 1] * stride];
+    const float *c = &positions[indices[i + 2] * stride];
+
+    const float u[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+    const float v[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+    float n[3] = {
+      u[1] * v[2] - u[2] * v[1],
+      u[2] * v[0] - u[0] * v[2],
+      u[0] * v[1] - u[1] * v[0],
+    };
+
+    const float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    if (length <= 0) continue;
+
+    for (uint32_t k = 0; k < 3; k++) {
+      n[k] /= length;
+      axis[k] += n[k];
+    }
+
+    normals.insert(normals.end(), n, n + 3);
+  }
+
+  const float length =
+    std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+  if (length <= 0) return;
+
+  float spread = 1;
+  for (size_t i = 0; i < normals.size(); i += 3) {
+    const float dot = (normals[i] * axis[0] + normals[i + 1] * axis[1] +
+                       normals[i + 2] * axis[2]) /
+                      length;
+    spread = std::min(spread, dot);
+  }
+
+  // cones wider than a hemisphere never cull anything
+  if (spread <= .1f) return;
+
+  for (uint32_t k = 0; k < 3; k++) {
+    meshlet.axis[k] = axis[k] / length;
+  }
+
+  meshlet.cutoff = std::sqrt(1 - spread * spread);
+}
+
+} // namespace
+
+MeshletMesh buildMeshlets(
+  const std::span<const uint32_t> indices,
+  const std::span<const float> positions,
+  const uint32_t stride,
+  const uint32_t maxTriangles
+) {
+  const uint32_t triangleCount = indices.size() / 3;
+  const uint32_t vertexCount = positions.size() / stride;
+
+  MeshletMesh mesh;
+  if (!triangleCount || !vertexCount || !maxTriangles) return mesh;
+
+  const std::span<const uint32_t> triangles = indices.first(triangleCount * 3);
+  const TriangleAdjacency adjacency(triangles, vertexCount);
+
+  // store triangle centroids to keep clusters compact
+  std::vector<float> centroids(triangleCount * 3);
+
+  for (uint32_t triangle = 0; triangle < triangleCount; triangle++) {
+    for (uint32_t corner = 0; corner < 3; corner++) {
+      const float *p = &positions[triangles[triangle * 3 + corner] * stride];
+
+      for (uint32_t axis = 0; axis < 3; axis++) {
+        centroids[triangle * 3 + axis] += p[axis] / 3;
+      }
+    }
+  }
+
+  std::vector<bool> emitted(triangleCount, false);
+  std::vector<uint32_t> owners(vertexCount, UINT32_MAX);
+  std::vector<uint32_t> candidates;
+  mesh.indices.reserve(triangleCount * 3);
+
+  uint32_t cursor = 0;
+
+  while (cursor < triangleCount) {
+    if (emitted[cursor]) {
+      cursor++;
+      continue;
+    }
+
+    Meshlet meshlet;
+    meshlet.firstIndex = mesh.indices.size();
+
+    const uint32_t owner = mesh.meshlets.size();
+    float center[3] = {0, 0, 0};
+    uint32_t size = 0;
+
+    candidates.clear();
+
+    // emits a triangle & queues the triangles sharing its vertices
+    const auto emit = [&](uint32_t triangle) {
+      emitted[triangle] = true;
+      size++;
+
+      for (uint32_t axis = 0; axis < 3; axis++) {
+        center[axis] += (centroids[triangle * 3 + axis] - center[axis]) / size;
+      }
+
+      for (uint32_t corner = 0; corner < 3; corner++) {
+        const uint32_t vertex = triangles[triangle * 3 + corner];
+        mesh.indices.push_back(vertex);
+
+        if (owners[vertex] == owner) continue;
+        owners[vertex] = owner;
+
+        const uint32_t first = adjacency.offsets[vertex];
+        const uint32_t last = adjacency.offsets[vertex + 1];
+
+        for (uint32_t i = first; i < last; i++) {
+          if (!emitted[adjacency.triangles[i]]) {
+            candidates.push_back(adjacency.triangles[i]);
+          }
+        }
+      }
+    };
+
+    emit(cursor);
+
+    // grow with triangles adding the fewest vertices, closest ones first
+    while (size < maxTriangles) {
+      std::erase_if(candidates, [&](uint32_t t) { return emitted[t]; });
+      if (candidates.empty()) break;
+
+      uint32_t best = candidates[0];
+      uint32_t bestVertices = UINT32_MAX;
+      float bestDistance = FLT_MAX;
+
+      for (const uint32_t triangle : candidates) {
+        uint32_t vertices = 0;
+        for (uint32_t corner = 0; corner < 3; corner++) {
+          vertices += owners[triangles[triangle * 3 + corner]] != owner;
+        }
+
+        float distance = 0;
+        for (uint32_t axis = 0; axis < 3; axis++) {
+          const float delta = centroids[triangle * 3 + axis] - center[axis];
+          distance += delta * delta;
+        }
+
+        if (vertices > bestVertices) continue;
+        if (vertices == bestVertices && distance >= bestDistance) continue;
+
+        best = triangle;
+        bestVertices = vertices;
+        bestDistance = distance;
+      }
+
+      emit(best);
+    }
+
+    meshlet.count = mesh.indices.size() - meshlet.firstIndex;
+    computeBounds(
+      meshlet,
+      std::span(mesh.indices).subspan(meshlet.firstIndex, meshlet.count),
+      positions,
+      stride
+    );
+
+    mesh.meshlets.push_back(meshlet);
+  }
+
+  return mesh;
+}
+
+} // namespace stem
@@ -0,0 +1,544 @@
+#include <cmath>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <cstring>
+#include <exception>
+#include <algorithm>
+#include <unordered_map>
+
+#include <stem/Bounds.hpp>
+#include <stem/MappedFile.hpp>
+#include <stem/ObjImporter.hpp>
+
+namespace stem {
+
+namespace {
+
+/// @brief The smallest number of bytes parsed by a single chunk
+constexpr size_t MIN_CHUNK_SIZE = 1 << 20;
+
+/// @brief The number of chunks & dedup shards given to every thread, so
+/// uneven ones balance out
+constexpr uint32_t TASKS_PER_THREAD = 4;
+
+/// @brief Shifts relative indices below zero until their chunk is resolved
+constexpr int64_t RELATIVE_BIAS = 1 << 30;
+
+/// @brief Stores a face corner as one-based position, texture coordinate &
+/// normal indices, zero when missing
+struct Corner {
+  /// @brief The position index
+  int32_t position;
+
+  /// @brief The texture coordinate index
+  int32_t texcoord;
+
+  /// @brief The normal index
+  int32_t normal;
+
+  /// @brief Compares corners referencing the same values
+  /// @param other The corner to compare with
+  /// @return Whether both corners are the same
+  bool operator==(const Corner &other) const = default;
+};
+
+/// @brief Hashes corners, mixing every index
+struct CornerHash {
+  /// @brief Combines the corner indices into a single hash
+  /// @param corner The corner to hash
+  /// @return The corner hash
+  size_t operator()(const Corner &corner) const {
+    uint64_t hash = (uint32_t)corner.position * 0x9E3779B97F4A7C15ull;
+    hash ^= (uint32_t)corner.texcoord * 0xC2B2AE3D27D4EB4Full;
+    hash ^= (uint32_t)corner.normal * 0x165667B19E3779F9ull;
+    return hash ^ (hash >> 29);
+  }
+};
+
+/// @brief Stores the values & faces parsed from a chunk of lines
+struct Chunk {
+  /// @brief The chunk source text
+  std::string_view source;
+
+  /// @brief The xyz positions
+  std::vector<float> positions;
+
+  /// @brief The uv texture coordinates
+  std::vector<float> texcoords;
+
+  /// @brief The xyz normals
+  std::vector<float> normals;
+
+  /// @brief The triangle corners, relative indices stored negative & zero
+  /// based against the chunk' own values
+  std::vector<Corner> corners;
+
+  /// @brief The index of the first corner in the whole file
+  size_t firstCorner = 0;
+
+  /// @brief The first error met while parsing or resolving the chunk
+  std::string error;
+};
+
+/// @brief Runs tasks over a pool of threads, each picking the next task
+/// The first exception thrown by a task stops the remaining tasks & is
+/// rethrown once every thread joined
+/// @param count The number of tasks
+/// @param threads The number of threads, the caller included
+/// @param task The task to run with a task index
+/// @return void
+template <typename Task>
+void runParallel(const uint32_t count, const uint32_t threads, Task task) {
+  std::atomic<uint32_t> next = 0;
+  std::exception_ptr exception;
+  std::mutex mutex;
+
+  // exceptions escaping a thread would terminate the program
+  const auto work = [&]() {
+    try {
+      for (uint32_t index; (index = next++) < count;) task(index);
+    } catch (...) {
+      next = count;
+
+      const std::lock_guard<std::mutex> lock(mutex);
+      if (!exception) exception = std::current_exception();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (uint32_t worker = 1; worker < std::min(threads, count); worker++) {
+    workers.emplace_back(work);
+  }
+
+  work();
+
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+
+  if (exception) std::rethrow_exception(exception);
+}
+
+/// @brief Returns whether a character separates tokens on a line
+/// @param character The character to test
+/// @return Whether the character is a space or a tab
+bool isBlank(const char character) {
+  return character == ' ' || character == '\t';
+}
+
+/// @brief Parses a decimal float without locale or stream overhead
+/// Up to 19 significant digits are accumulated as an integer & scaled once
+/// @param cursor The first character, moved past the float
+/// @param end The end of the text
+/// @return The float, zero when none could be read
+float parseFloat(const char *&cursor, const char *end) {
+  static constexpr double powers[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+  };
+
+  while (cursor < end && isBlank(*cursor)) cursor++;
+
+  const bool negative = cursor < end && *cursor == '-';
+  if (cursor < end && (*cursor == '-' || *cursor == '+')) cursor++;
+
+  uint64_t mantissa = 0;
+  int32_t exponent = 0;
+  uint32_t digits = 0;
+
+  // keep significant digits, counting the dropped ones in the exponent
+  const auto readDigits = [&](const bool fraction) {
+    for (; cursor < end && (uint8_t)(*cursor - '0') < 10; cursor++) {
+      const uint32_t digit = *cursor - '0';
+
+      if (digits < 19) {
+        mantissa = mantissa * 10 + digit;
+        digits += mantissa != 0;
+        exponent -= fraction;
+      } else {
+        exponent += !fraction;
+      }
+    }
+  };
+
+  readDigits(false);
+  if (cursor < end && *cursor == '.') {
+    cursor++;
+    readDigits(true);
+  }
+
+  if (cursor < end && (*cursor == 'e' || *cursor == 'E')) {
+    cursor++;
+
+    const bool negativeExponent = cursor < end && *cursor == '-';
+    if (cursor < end && (*cursor == '-' || *cursor == '+')) cursor++;
+
+    int32_t value = 0;
+    for (; cursor < end && (uint8_t)(*cursor - '0') < 10; cursor++) {
+      value = std::min(value * 10 + (*cursor - '0'), 1000);
+    }
+
+    exponent += negativeExponent ? -value : value;
+  }
+
+  double result = (double)mantissa;
+  if (exponent >= 0 && exponent <= 22) result *= powers[exponent];
+  else if (exponent < 0 && exponent >= -22) result /= powers[-exponent];
+  else result *= std::pow(10., exponent);
+
+  return (float)(negative ? -result : result);
+}
+
+/// @brief Parses a signed decimal integer
+/// @param cursor The first character, moved past the integer
+/// @param end The end of the text
+/// @return The integer, zero when none could be read
+int32_t parseInteger(const char *&cursor, const char *end) {
+  const bool negative = cursor < end && *cursor == '-';
+  if (cursor < end && (*cursor == '-' || *cursor == '+')) cursor++;
+
+  int64_t value = 0;
+  for (; cursor < end && (uint8_t)(*cursor - '0') < 10; cursor++) {
+    value = std::min<int64_t>(value * 10 + (*cursor - '0'), INT32_MAX);
+  }
+
+  return (int32_t)(negative ? -value : value);
+}
+
+/// @brief Converts a face index to a chunk-resolvable index
+/// One-based indices are kept, relative ones become one-based from the chunk
+/// start, which may reach previous chunks, & are biased below zero
+/// @param index The index read from the face
+/// @param count The number of values the chunk parsed so far
+/// @return The stored index
+int32_t storeIndex(const int32_t index, const size_t count) {
+  if (index >= 0) return index;
+
+  const int64_t stored = (int64_t)count + index + 1 - RELATIVE_BIAS;
+  return (int32_t)std::max<int64_t>(stored, INT32_MIN);
+}
+
+/// @brief Parses every line of a chunk
+/// @param chunk The chunk to parse
+/// @return void
+void parseChunk(Chunk &chunk) {
+  const char *cursor = chunk.source.data();
+  const char *end = cursor + chunk.source.size();
+  std::vector<Corner> face;
+
+  while (cursor < end) {
+    const char *line = (const char *)std::memchr(cursor, '\n', end - cursor);
+    const char *lineEnd = line ? line : end;
+
+    while (cursor < lineEnd && isBlank(*cursor)) cursor++;
+
+    const size_t length = lineEnd - cursor;
+    const char type = length ? cursor[0] : '#';
+    const char subtype = length > 1 ? cursor[1] : ' ';
+
+    if (type == 'v' && isBlank(subtype)) {
+      cursor++;
+      for (uint32_t axis = 0; axis < 3; axis++) {
+        chunk.positions.push_back(parseFloat(cursor, lineEnd));
+      }
+    } else if (type == 'v' && subtype == 't') {
+      cursor += 2;
+      for (uint32_t axis = 0; axis < 2; axis++) {
+        chunk.texcoords.push_back(parseFloat(cursor, lineEnd));
+      }
+    } else if (type == 'v' && subtype == 'n') {
+      cursor += 2;
+      for (uint32_t axis = 0; axis < 3; axis++) {
+        chunk.normals.push_back(parseFloat(cursor, lineEnd));
+      }
+    } else if (type == 'f' && isBlank(subtype)) {
+      cursor++;
+      face.clear();
+
+      // read v, v/vt, v//vn & v/vt/vn corners
+      while (true) {
+        while (cursor < lineEnd && isBlank(*cursor)) cursor++;
+        if (cursor >= lineEnd || *cursor == '\r' || *cursor == '#') break;
+
+        Corner corner = {0, 0, 0};
+        const int32_t position = parseInteger(cursor, lineEnd);
+        corner.position = storeIndex(position, chunk.positions.size() / 3);
+
+        if (cursor < lineEnd && *cursor == '/') {
+          cursor++;
+          const int32_t texcoord = parseInteger(cursor, lineEnd);
+          corner.texcoord = storeIndex(texcoord, chunk.texcoords.size() / 2);
+        }
+
+        if (cursor < lineEnd && *cursor == '/') {
+          cursor++;
+          const int32_t normal = parseInteger(cursor, lineEnd);
+          corner.normal = storeIndex(normal, chunk.normals.size() / 3);
+        }
+
+        // skip anything left of a malformed corner
+        while (cursor < lineEnd && !isBlank(*cursor)) cursor++;
+        face.push_back(corner);
+      }
+
+      for (size_t i = 2; i < face.size(); i++) {
+        chunk.corners.push_back(face[0]);
+        chunk.corners.push_back(face[i - 1]);
+        chunk.corners.push_back(face[i]);
+      }
+    }
+
+    cursor = line ? line + 1 : end;
+  }
+}
+
+/// @brief Resolves a stored index against the values of previous chunks
+/// @param index The stored index
+/// @param base The number of values parsed by previous chunks
+/// @param total The number of values in the file
+/// @param required Whether the index must be present
+/// @return The one-based index or -1 when out of range
+int32_t resolveIndex(
+  const int32_t index,
+  const size_t base,
+  const size_t total,
+  const bool required
+) {
+  if (!index) return required ? -1 : 0;
+
+  const int64_t resolved =
+    index > 0 ? index : (int64_t)base + index + RELATIVE_BIAS;
+  return resolved >= 1 && resolved <= (int64_t)total ? (int32_t)resolved : -1;
+}
+
+} // namespace
+
+ObjImportError::ObjImportError(
+  const std::string path,
+  const std::string reason
+) {
+  _message = "Obj file " + path + " " + reason;
+}
+
+Geometry ObjMesh::createGeometry(const uint32_t usage) const {
+  Geometry geometry;
+  const FloatBuffer::Usage bufferUsage = (FloatBuffer::Usage)usage;
+
+  // bound the geometry from the positions still in memory
+  geometry.setAttribute(
+    {.name = "position",
+     .size = 3,
+     .buffer = FloatBuffer(positions, bufferUsage)},
+    positions
+  );
+
+  if (!normals.empty()) {
+    geometry.setAttribute(
+      {.name = "normal", .size = 3, .buffer = FloatBuffer(normals, bufferUsage)}
+    );
+  }
+
+  if (!texcoords.empty()) {
+    geometry.setAttribute(
+      {.name = "uv", .size = 2, .buffer = FloatBuffer(texcoords, bufferUsage)}
+    );
+  }
+
+  geometry.setIndex(createIndexBuffer(indices, usage));
+
+  return geometry;
+}
+
+ObjMesh parseObj(
+  const std::string_view source,
+  const uint32_t threads,
+  const std::string path
+) {
+  const uint32_t workers =
+    threads ? threads : std::max(std::thread::hardware_concurrency(), 1u);
+
+  // split the text on line boundaries
+  const size_t chunkCount = std::clamp<size_t>(
+    source.size() / MIN_CHUNK_SIZE, 1, workers * TASKS_PER_THREAD
+  );
+
+  std::vector<Chunk> chunks;
+  size_t start = 0;
+
+  for (size_t index = 1; start < source.size(); index++) {
+    // end chunks past the first line break after their even share
+    size_t end = source.find('\n', source.size() * index / chunkCount);
+    end = end == std::string_view::npos ? source.size() : end + 1;
+
+    if (end <= start) continue;
+
+    chunks.emplace_back().source = source.substr(start, end - start);
+    start = end;
+  }
+
+  runParallel(chunks.size(), workers, [&](uint32_t index) {
+    parseChunk(chunks[index]);
+  });
+
+  // offset every chunk by the values & corners of the previous ones
+  std::vector<size_t> positionBases, texcoordBases, normalBases;
+  size_t positionCount = 0, texcoordCount = 0, normalCount = 0;
+  size_t cornerCount = 0;
+
+  for (Chunk &chunk : chunks) {
+    positionBases.push_back(positionCount);
+    texcoordBases.push_back(texcoordCount);
+    normalBases.push_back(normalCount);
+    chunk.firstCorner = cornerCount;
+
+    positionCount += chunk.positions.size() / 3;
+    texcoordCount += chunk.texcoords.size() / 2;
+    normalCount += chunk.normals.size() / 3;
+    cornerCount += chunk.corners.size();
+  }
+
+  // resolve indices & bucket corners into the dedup shards
+  const uint32_t shardCount = workers * TASKS_PER_THREAD;
+  std::vector<std::vector<std::vector<uint32_t>>> buckets(
+    chunks.size(), std::vector<std::vector<uint32_t>>(shardCount)
+  );
+
+  runParallel(chunks.size(), workers, [&](uint32_t index) {
+    Chunk &chunk = chunks[index];
+
+    for (size_t i = 0; i < chunk.corners.size(); i++) {
+      Corner &corner = chunk.corners[i];
+      corner.position = resolveIndex(
+        corner.position, positionBases[index], positionCount, true
+      );
+      corner.texcoord = resolveIndex(
+        corner.texcoord, texcoordBases[index], texcoordCount, false
+      );
+      corner.normal = resolveIndex(
+        corner.normal, normalBases[index], normalCount, false
+      );
+
+      if (corner.position < 0 || corner.texcoord < 0 || corner.normal < 0) {
+        chunk.error = "has a face referencing a missing vertex";
+        return;
+      }
+
+      const uint32_t shard = (CornerHash()(corner) >> 32) % shardCount;
+      buckets[index][shard].push_back(chunk.firstCorner + i);
+    }
+  });
+
+  for (const Chunk &chunk : chunks) {
+    if (!chunk.error.empty()) throw ObjImportError(path, chunk.error);
+  }
+
+  if (cornerCount > UINT32_MAX) {
+    throw ObjImportError(path, "has too many face corners");
+  }
+
+  // gather corners so shards can read them by file order
+  std::vector<Corner> corners(cornerCount);
+
+  runParallel(chunks.size(), workers, [&](uint32_t index) {
+    const Chunk &chunk = chunks[index];
+    std::copy(
+      chunk.corners.begin(),
+      chunk.corners.end(),
+      corners.begin() + chunk.firstCorner
+    );
+  });
+
+  // each shard maps its corners onto their first occurrence, lock free
+  std::vector<uint32_t> firsts(cornerCount);
+
+  runParallel(shardCount, workers, [&](uint32_t shard) {
+    std::unordered_map<Corner, uint32_t, CornerHash> map;
+
+    for (const auto &chunkBuckets : buckets) {
+      for (const uint32_t corner : chunkBuckets[shard]) {
+        firsts[corner] = map.try_emplace(corners[corner], corner).first->second;
+      }
+    }
+  });
+
+  // number unique corners in file order, keeping imports deterministic
+  ObjMesh mesh;
+  mesh.indices.resize(cornerCount);
+
+  const bool hasNormals = std::any_of(
+    corners.begin(), corners.end(), [](auto &c) { return c.normal; }
+  );
+  const bool hasTexcoords = std::any_of(
+    corners.begin(), corners.end(), [](auto &c) { return c.texcoord; }
+  );
+
+  // gather values from every chunk at once
+  const auto gather = [&](auto member, uint32_t size, size_t count) {
+    std::vector<float> values;
+    values.reserve(count * size);
+
+    for (const Chunk &chunk : chunks) {
+      const std::vector<float> &source = chunk.*member;
+      values.insert(values.end(), source.begin(), source.end());
+    }
+
+    return values;
+  };
+
+  const std::vector<float> positions =
+    gather(&Chunk::positions, 3, positionCount);
+  const std::vector<float> texcoords =
+    gather(&Chunk::texcoords, 2, texcoordCount);
+  const std::vector<float> normals = gather(&Chunk::normals, 3, normalCount);
+
+  uint32_t vertexCount = 0;
+
+  for (uint32_t index = 0; index < cornerCount; index++) {
+    if (firsts[index] != index) {
+      mesh.indices[index] = mesh.indices[firsts[index]];
+      continue;
+    }
+
+    mesh.indices[index] = vertexCount++;
+    const Corner &corner = corners[index];
+
+    const float *position = &positions[(corner.position - 1) * 3];
+    mesh.positions.insert(mesh.positions.end(), position, position + 3);
+
+    if (hasTexcoords) {
+      if (corner.texcoord) {
+        const float *texcoord = &texcoords[(corner.texcoord - 1) * 2];
+        mesh.texcoords.insert(mesh.texcoords.end(), texcoord, texcoord + 2);
+      } else {
+        mesh.texcoords.insert(mesh.texcoords.end(), 2, 0.f);
+      }
+    }
+
+    if (hasNormals) {
+      if (corner.normal) {
+        const float *normal = &normals[(corner.normal - 1) * 3];
+        mesh.normals.insert(mesh.normals.end(), normal, normal + 3);
+      } else {
+        mesh.normals.insert(mesh.normals.end(), 3, 0.f);
+      }
+    }
+  }
+
+  return mesh;
+}
+
+ObjMesh importObj(const std::string path, const uint32_t threads) {
+  try {
+    const MappedFile file(path);
+    const std::span<const uint8_t> data = file.getData();
+
+    return parseObj(
+      std::string_view((const char *)data.data(), data.size()), threads, path
+    );
+  } catch (const MappedFileError &) {
+    throw ObjImportError(path, "can not be opened");
+  }
+}
+
+} // namespace stem
@@ -1,5 +1,7 @@
 #include <glm/gtc/type_ptr.hpp>
 #include <stem/Error.hpp>
+#include <stem/Capabilities.hpp>
+#include <stem/DeletionQueue.hpp>
 #include <stem/Program.hpp>
 
 namespace stem {
@@ -59,6 +61,7 @@ Program::Program(const Settings settings) {
   compile(GL_VERTEX_SHADER, settings.vertex);
   compile(GL_GEOMETRY_SHADER, settings.geometry);
   compile(GL_FRAGMENT_SHADER, settings.fragment);
+  compile(GL_COMPUTE_SHADER, settings.compute);
 
   // link & validate
   glAssert(glLinkProgram(_id));
@@ -99,6 +102,15 @@ Program::Program(const Settings settings) {
     setUniform(uniform);
   }
 
+  // iterate block settings
+  for (const BlockBinding &block : settings.uniformBlocks) {
+    setUniformBlock(block.first, block.second);
+  }
+
+  for (const BlockBinding &block : settings.storageBlocks) {
+    setStorageBlock(block.first, block.second);
+  }
+
   // get active attributes count
   glAssert(glGetProgramiv(_id, GL_ACTIVE_ATTRIBUTES, &count));
 
@@ -125,6 +137,27 @@ Program::Program(const Settings settings) {
   }
 }
 
+Program::Program(Program &&other) noexcept {
+  *this = std::move(other);
+}
+
+Program &Program::operator=(Program &&other) noexcept {
+  if (this == &other) return *this;
+
+  // release our own program before taking the other one
+  destroy();
+
+  _id = std::exchange(other._id, 0);
+  _activeUniforms = std::exchange(other._activeUniforms, {});
+  _activeAttributes = std::exchange(other._activeAttributes, {});
+
+  return *this;
+}
+
+Program::~Program() {
+  destroy();
+}
+
 const uint32_t Program::getId() const {
   return _id;
 }
@@ -137,6 +170,13 @@ void Program::setUniform(const std::string name, const UniformValue value) {
   // store the uniform value
   ActiveUniform &activeUniform = iterator->second;
   activeUniform.value = value;
+
+  // upload right away when the program can be edited without binding it
+  if (hasDirectStateAccess()) {
+    upload(activeUniform);
+    return;
+  }
+
   activeUniform.needsUpdate = true;
 }
 
@@ -144,6 +184,24 @@ void Program::setUniform(const Uniform uniform) {
   setUniform(uniform.first, uniform.second);
 };
 
+void Program::setUniformBlock(const std::string name, const uint32_t binding) {
+  // find matching uniform block or skip
+  const uint32_t index = glGetUniformBlockIndex(_id, name.c_str());
+  if (index == GL_INVALID_INDEX) return;
+
+  // binding points are program state & need no bound program
+  glAssert(glUniformBlockBinding(_id, index, binding));
+}
+
+void Program::setStorageBlock(const std::string name, const uint32_t binding) {
+  // find matching shader storage block or skip
+  const uint32_t index =
+    glGetProgramResourceIndex(_id, GL_SHADER_STORAGE_BLOCK, name.c_str());
+  if (index == GL_INVALID_INDEX) return;
+
+  glAssert(glShaderStorageBlockBinding(_id, index, binding));
+}
+
 const std::optional<Program::ActiveAttribute>
 Program::getAttribute(const std::string name) const {
   auto iterator = _activeAttributes.find(name);
@@ -161,6 +219,9 @@ void Program::use() {
   // bind program for usage
   glAssert(glUseProgram(_id));
 
+  // direct state access uniforms are already uploaded
+  if (hasDirectStateAccess()) return;
+
   // iterate active uniforms
   for (std::pair<const std::string, ActiveUniform> &pair : _activeUniforms) {
     // get a reference to the active uniform
@@ -170,50 +231,110 @@ void Program::use() {
     if (!uniform.needsUpdate) continue;
 
     // send the value the program on the gpu
-    switch (uniform.type) {
-    case GL_INT:
-      glAssert(glUniform1i(uniform.location, std::get<int>(uniform.value)));
-      break;
-    case GL_UNSIGNED_INT:
-      glAssert(
-        glUniform1ui(uniform.location, std::get<unsigned int>(uniform.value))
-      );
-      break;
-    case GL_FLOAT:
-      glAssert(glUniform1f(uniform.location, std::get<float>(uniform.value)));
-      break;
-    case GL_DOUBLE:
-      glAssert(glUniform1d(uniform.location, std::get<double>(uniform.value)));
-      break;
-    case GL_INT_VEC2:
-      glAssert(glUniform2iv(
-        uniform.location, 1, glm::value_ptr(std::get<Vector2i>(uniform.value))
-      ));
-      break;
-    case GL_UNSIGNED_INT_VEC2:
-      glAssert(glUniform2uiv(
-        uniform.location, 1, glm::value_ptr(std::get<Vector2u>(uniform.value))
-      ));
-      break;
-    case GL_FLOAT_VEC2:
-      glAssert(glUniform2fv(
-        uniform.location, 1, glm::value_ptr(std::get<Vector2f>(uniform.value))
-      ));
-      break;
-    case GL_DOUBLE_VEC2:
-      glAssert(glUniform2dv(
-        uniform.location, 1, glm::value_ptr(std::get<Vector2d>(uniform.value))
-      ));
-      break;
-    }
+    upload(uniform);
 
     // mark uniform as updated
     uniform.needsUpdate = false;
   }
 }
 
+void Program::dispatch(const uint32_t x, const uint32_t y, const uint32_t z) {
+  use();
+  glAssert(glDispatchCompute(x, y, z));
+}
+
+void Program::upload(const ActiveUniform &uniform) const {
+  // edit the program directly or through the bound program
+  const bool dsa = hasDirectStateAccess();
+  const int location = uniform.location;
+
+  switch (uniform.type) {
+  case GL_INT: {
+    const int value = std::get<int>(uniform.value);
+    if (dsa) {
+      glAssert(glProgramUniform1i(_id, location, value));
+    } else {
+      glAssert(glUniform1i(location, value));
+    }
+    break;
+  }
+  case GL_UNSIGNED_INT: {
+    const unsigned int value = std::get<unsigned int>(uniform.value);
+    if (dsa) {
+      glAssert(glProgramUniform1ui(_id, location, value));
+    } else {
+      glAssert(glUniform1ui(location, value));
+    }
+    break;
+  }
+  case GL_FLOAT: {
+    const float value = std::get<float>(uniform.value);
+    if (dsa) {
+      glAssert(glProgramUniform1f(_id, location, value));
+    } else {
+      glAssert(glUniform1f(location, value));
+    }
+    break;
+  }
+  case GL_DOUBLE: {
+    const double value = std::get<double>(uniform.value);
+    if (dsa) {
+      glAssert(glProgramUniform1d(_id, location, value));
+    } else {
+      glAssert(glUniform1d(location, value));
+    }
+    break;
+  }
+  case GL_INT_VEC2: {
+    const int *value = glm::value_ptr(std::get<Vector2i>(uniform.value));
+    if (dsa) {
+      glAssert(glProgramUniform2iv(_id, location, 1, value));
+    } else {
+      glAssert(glUniform2iv(location, 1, value));
+    }
+    break;
+  }
+  case GL_UNSIGNED_INT_VEC2: {
+    const unsigned int *value =
+      glm::value_ptr(std::get<Vector2u>(uniform.value));
+    if (dsa) {
+      glAssert(glProgramUniform2uiv(_id, location, 1, value));
+    } else {
+      glAssert(glUniform2uiv(location, 1, value));
+    }
+    break;
+  }
+  case GL_FLOAT_VEC2: {
+    const float *value = glm::value_ptr(std::get<Vector2f>(uniform.value));
+    if (dsa) {
+      glAssert(glProgramUniform2fv(_id, location, 1, value));
+    } else {
+      glAssert(glUniform2fv(location, 1, value));
+    }
+    break;
+  }
+  case GL_DOUBLE_VEC2: {
+    const double *value = glm::value_ptr(std::get<Vector2d>(uniform.value));
+    if (dsa) {
+      glAssert(glProgramUniform2dv(_id, location, 1, value));
+    } else {
+      glAssert(glUniform2dv(location, 1, value));
+    }
+    break;
+  }
+  }
+}
+
 void Program::destroy() {
-  glAssert(glDeleteProgram(_id));
+  if (!_id) return;
+
+  // defer the deletion until the gpu is done with in flight frames
+  if (DeletionQueue *queue = DeletionQueue::getCurrent()) {
+    queue->deleteProgram(_id);
+  } else {
+    glAssert(glDeleteProgram(_id));
+  }
+
   _id = 0;
 }
 
@@ -0,0 +1,360 @@
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+
+#include <stem/Quantize.hpp>
+
+#if defined(__x86_64__) || defined(_M_X64)
+  #define STEM_SSE2
+  #include <immintrin.h>
+#endif
+
+#if defined(STEM_SSE2) && (defined(__GNUC__) || defined(__clang__))
+  #define STEM_AVX2
+#endif
+
+namespace stem {
+
+namespace {
+
+/// @brief Converts a float to half precision bits, rounding to nearest even
+/// @param value The float to convert
+/// @return The half precision bits
+uint16_t toHalf(const float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+
+  const uint32_t sign = bits & 0x80000000u;
+  bits ^= sign;
+
+  uint32_t half;
+
+  // overflow to infinity, keep nans quiet
+  if (bits >= (127u + 16u) << 23) {
+    half = bits > 0x7F800000u ? 0x7E00u : 0x7C00u;
+  }
+
+  // subnormals are rounded by the fpu through a magic addition
+  else if (bits < 113u << 23) {
+    const uint32_t magicBits = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+
+    float magic, sum;
+    std::memcpy(&magic, &magicBits, sizeof(magic));
+    std::memcpy(&sum, &bits, sizeof(sum));
+    sum += magic;
+
+    std::memcpy(&half, &sum, sizeof(half));
+    half -= magicBits;
+  }
+
+  // normals rebias the exponent & round the mantissa to nearest even
+  else {
+    const uint32_t odd = (bits >> 13) & 1u;
+    bits += ((uint32_t)(15 - 127) << 23) + 0xFFFu + odd;
+    half = bits >> 13;
+  }
+
+  return (uint16_t)(half | (sign >> 16));
+}
+
+/// @brief Converts a float to a rounded & clamped fixed-point value
+/// Nans convert to the lowest value, as they do through the simd kernels
+/// @param value The float to convert
+/// @param min The lowest normalized value
+/// @param scale The fixed-point value of 1
+/// @return The fixed-point value
+int32_t toFixed(const float value, const float min, const float scale) {
+  const float clamped = std::isnan(value) ? min : std::clamp(value, min, 1.f);
+  return (int32_t)std::lrintf(clamped * scale);
+}
+
+/// @brief Converts floats to fixed-point values one by one
+/// @param source The floats to convert
+/// @param target The fixed-point values
+/// @param count The number of values to convert
+/// @param min The lowest normalized value
+/// @param scale The fixed-point value of 1
+/// @return void
+template <typename Fixed>
+void toFixed(
+  const float *source,
+  Fixed *target,
+  const size_t count,
+  const float min,
+  const float scale
+) {
+  for (size_t index = 0; index < count; index++) {
+    target[index].value = toFixed(source[index], min, scale);
+  }
+}
+
+#ifdef STEM_SSE2
+
+/// @brief Loads, clamps & rounds 8 floats to two vectors of 32-bit integers
+/// @param source The floats to convert
+/// @param min The lowest normalized value
+/// @param scale The fixed-point value of 1
+/// @param low The first four converted values
+/// @param high The last four converted values
+/// @return void
+inline void loadFixed(
+  const float *source,
+  const __m128 min,
+  const __m128 scale,
+  __m128i &low,
+  __m128i &high
+) {
+  const __m128 one = _mm_set1_ps(1.f);
+
+  const __m128 a = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(source), min), one);
+  const __m128 b = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + 4), min), one);
+
+  low = _mm_cvtps_epi32(_mm_mul_ps(a, scale));
+  high = _mm_cvtps_epi32(_mm_mul_ps(b, scale));
+}
+
+#endif
+
+#ifdef STEM_AVX2
+
+/// @brief Converts floats to half precision floats 8 at a time with f16c
+/// @param source The floats to convert
+/// @param target The converted values
+/// @param count The number of values to convert
+/// @return The number of converted values
+__attribute__((target("avx,f16c"))) size_t
+toHalfF16C(const float *source, Half *target, const size_t count) {
+  size_t index = 0;
+
+  for (; index + 8 <= count; index += 8) {
+    const __m256 values = _mm256_loadu_ps(source + index);
+    const __m128i halves =
+      _mm256_cvtps_ph(values, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    _mm_storeu_si128((__m128i *)(target + index), halves);
+  }
+
+  return index;
+}
+
+/// @brief Converts floats to signed 16-bit fixed-point 16 at a time with avx2
+/// @param source The floats to convert
+/// @param target The converted values
+/// @param count The number of values to convert
+/// @param min The lowest normalized value
+/// @param scale The fixed-point value of 1
+/// @param bias The value subtracted before saturating to signed shorts
+/// @return The number of converted values
+__attribute__((target("avx2"))) size_t toFixed16AVX2(
+  const float *source,
+  int16_t *target,
+  const size_t count,
+  const float min,
+  const float scale,
+  const int32_t bias
+) {
+  const __m256 low = _mm256_set1_ps(min);
+  const __m256 one = _mm256_set1_ps(1.f);
+  const __m256 factor = _mm256_set1_ps(scale);
+  const __m256i offset = _mm256_set1_epi32(bias);
+  const __m256i flip = _mm256_set1_epi16((int16_t)bias);
+
+  size_t index = 0;
+
+  for (; index + 16 <= count; index += 16) {
+    __m256 a = _mm256_loadu_ps(source + index);
+    __m256 b = _mm256_loadu_ps(source + index + 8);
+
+    a = _mm256_min_ps(_mm256_max_ps(a, low), one);
+    b = _mm256_min_ps(_mm256_max_ps(b, low), one);
+
+    const __m256i x =
+      _mm256_sub_epi32(_mm256_cvtps_epi32(_mm256_mul_ps(a, factor)), offset);
+    const __m256i y =
+      _mm256_sub_epi32(_mm256_cvtps_epi32(_mm256_mul_ps(b, factor)), offset);
+
+    // pack within lanes then restore the lane order
+    __m256i packed = _mm256_packs_epi32(x, y);
+    packed = _mm256_permute4x64_epi64(packed, 0xD8);
+    packed = _mm256_xor_si256(packed, flip);
+
+    _mm256_storeu_si256((__m256i *)(target + index), packed);
+  }
+
+  return index;
+}
+
+/// @brief Returns whether the cpu supports avx2 instructions
+/// @return Whether the cpu supports avx2 instructions
+bool hasAVX2() {
+  static const bool supported = __builtin_cpu_supports("avx2");
+  return supported;
+}
+
+/// @brief Returns whether the cpu supports f16c instructions
+/// @return Whether the cpu supports f16c instructions
+bool hasF16C() {
+  static const bool supported =
+    __builtin_cpu_supports("avx") && __builtin_cpu_supports("f16c");
+  return supported;
+}
+
+#endif
+
+/// @brief Converts floats to 16-bit fixed-point values
+/// @param source The floats to convert
+/// @param target The converted values
+/// @param count The number of values to convert
+/// @param min The lowest normalized value
+/// @param scale The fixed-point value of 1
+/// @param bias The value subtracted before saturating to signed shorts
+/// @return void
+template <typename Fixed>
+void toFixed16(
+  const float *source,
+  Fixed *target,
+  const size_t count,
+  const float min,
+  const float scale,
+  const int32_t bias
+) {
+  size_t index = 0;
+
+#ifdef STEM_AVX2
+  if (hasAVX2()) {
+    index = toFixed16AVX2(source, (int16_t *)target, count, min, scale, bias);
+  }
+#endif
+
+#ifdef STEM_SSE2
+  const __m128 low = _mm_set1_ps(min);
+  const __m128 factor = _mm_set1_ps(scale);
+  const __m128i offset = _mm_set1_epi32(bias);
+  const __m128i flip = _mm_set1_epi16((int16_t)bias);
+
+  for (; index + 8 <= count; index += 8) {
+    __m128i a, b;
+    loadFixed(source + index, low, factor, a, b);
+
+    // bias unsigned values into the signed range before saturating
+    a = _mm_sub_epi32(a, offset);
+    b = _mm_sub_epi32(b, offset);
+
+    const __m128i packed = _mm_xor_si128(_mm_packs_epi32(a, b), flip);
+    _mm_storeu_si128((__m128i *)(target + index), packed);
+  }
+#endif
+
+  toFixed(source + index, target + index, count - index, min, scale);
+}
+
+/// @brief Converts floats to 8-bit fixed-point values
+/// @param source The floats to convert
+/// @param target The converted values
+/// @param count The number of values to convert
+/// @param min The lowest normalized value
+/// @param scale The fixed-point value of 1
+/// @return void
+template <typename Fixed>
+void toFixed8(
+  const float *source,
+  Fixed *target,
+  const size_t count,
+  const float min,
+  const float scale
+) {
+  size_t index = 0;
+
+#ifdef STEM_SSE2
+  const __m128 low = _mm_set1_ps(min);
+  const __m128 factor = _mm_set1_ps(scale);
+
+  for (; index + 16 <= count; index += 16) {
+    __m128i a, b, c, d;
+    loadFixed(source + index, low, factor, a, b);
+    loadFixed(source + index + 8, low, factor, c, d);
+
+    // saturate to shorts then to signed or unsigned bytes
+    const __m128i x = _mm_packs_epi32(a, b);
+    const __m128i y = _mm_packs_epi32(c, d);
+    const __m128i packed =
+      min < 0.f ? _mm_packs_epi16(x, y) : _mm_packus_epi16(x, y);
+
+    _mm_storeu_si128((__m128i *)(target + index), packed);
+  }
+#endif
+
+  toFixed(source + index, target + index, count - index, min, scale);
+}
+
+} // namespace
+
+void quantize(
+  const std::span<const float> source,
+  const std::span<Half> target
+) {
+  const size_t count = std::min(source.size(), target.size());
+  size_t index = 0;
+
+#ifdef STEM_AVX2
+  if (hasF16C()) {
+    index = toHalfF16C(source.data(), target.data(), count);
+  }
+#endif
+
+  for (; index < count; index++) {
+    target[index].bits = toHalf(source[index]);
+  }
+}
+
+void quantize(
+  const std::span<const float> source,
+  const std::span<Snorm16> target
+) {
+  const size_t count = std::min(source.size(), target.size());
+  toFixed16(source.data(), target.data(), count, -1.f, 32767.f, 0);
+}
+
+void quantize(
+  const std::span<const float> source,
+  const std::span<Snorm8> target
+) {
+  const size_t count = std::min(source.size(), target.size());
+  toFixed8(source.data(), target.data(), count, -1.f, 127.f);
+}
+
+void quantize(
+  const std::span<const float> source,
+  const std::span<Unorm16> target
+) {
+  const size_t count = std::min(source.size(), target.size());
+  toFixed16(source.data(), target.data(), count, 0.f, 65535.f, 32768);
+}
+
+void quantize(
+  const std::span<const float> source,
+  const std::span<Unorm8> target
+) {
+  const size_t count = std::min(source.size(), target.size());
+  toFixed8(source.data(), target.data(), count, 0.f, 255.f);
+}
+
+void quantize(
+  const std::span<const float> source,
+  const std::span<Int2101010> target
+) {
+  const size_t count = std::min(source.size() / 4, target.size());
+
+  for (size_t index = 0; index < count; index++) {
+    const float *xyzw = source.data() + index * 4;
+
+    // pack two's complement components from the lowest bits up
+    const uint32_t x = toFixed(xyzw[0], -1.f, 511.f) & 0x3FF;
+    const uint32_t y = toFixed(xyzw[1], -1.f, 511.f) & 0x3FF;
+    const uint32_t z = toFixed(xyzw[2], -1.f, 511.f) & 0x3FF;
+    const uint32_t w = toFixed(xyzw[3], -1.f, 1.f) & 0x3;
+
+    target[index].bits = x | (y << 10) | (z << 20) | (w << 30);
+  }
+}
+
+} // namespace stem
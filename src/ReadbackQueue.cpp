@@ -0,0 +1,215 @@
+#include <cstddef>
+#include <utility>
+
+#include <stem/Error.hpp>
+#include <stem/Buffer.hpp>
+#include <stem/RingBuffer.hpp>
+#include <stem/Capabilities.hpp>
+#include <stem/ReadbackQueue.hpp>
+
+namespace stem {
+
+namespace {
+
+/// @brief The staging range alignment, enough for any value type view
+constexpr uint32_t ALIGNMENT = alignof(std::max_align_t);
+
+} // namespace
+
+ReadbackQueue::ReadbackQueue(const uint32_t capacity) : _capacity(capacity) {
+  // allocate & map the staging storage once, cached in client memory
+  const GLbitfield flags =
+    GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+  const GLbitfield storage = flags | GL_CLIENT_STORAGE_BIT;
+
+  if (hasDirectStateAccess()) {
+    glAssert(glCreateBuffers(1, &_id));
+    glAssert(glNamedBufferStorage(_id, capacity, nullptr, storage));
+    _data =
+      static_cast<uint8_t *>(glMapNamedBufferRange(_id, 0, capacity, flags));
+  } else {
+    glAssert(glGenBuffers(1, &_id));
+    glAssert(glBindBuffer(GL_COPY_WRITE_BUFFER, _id));
+
+    glAssert(
+      glBufferStorage(GL_COPY_WRITE_BUFFER, capacity, nullptr, storage)
+    );
+    _data = static_cast<uint8_t *>(
+      glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, capacity, flags)
+    );
+  }
+
+  // release the storage rather than reading back through a null pointer
+  if (!_data) {
+    const uint32_t id = std::exchange(_id, 0);
+    glAssert(glDeleteBuffers(1, &id));
+    throw BufferMapError(id);
+  }
+}
+
+ReadbackQueue::ReadbackQueue(ReadbackQueue &&other) noexcept {
+  *this = std::move(other);
+}
+
+ReadbackQueue &ReadbackQueue::operator=(ReadbackQueue &&other) noexcept {
+  if (this == &other) return *this;
+
+  // release our own staging before taking the other one
+  destroy();
+
+  _id = std::exchange(other._id, 0);
+  _capacity = other._capacity;
+  _data = std::exchange(other._data, nullptr);
+  _head = other._head;
+  _used = other._used;
+  _next = other._next;
+  _readbacks = std::exchange(other._readbacks, {});
+
+  return *this;
+}
+
+ReadbackQueue::~ReadbackQueue() {
+  destroy();
+}
+
+ReadbackQueue::Ticket ReadbackQueue::request(
+  const uint32_t buffer,
+  const uint32_t offset,
+  const uint32_t size
+) {
+  Readback *readback = reserve(size);
+  if (!readback) return 0;
+
+  if (size) copyBufferData(buffer, _id, offset, readback->offset, size);
+
+  return fence(*readback);
+}
+
+ReadbackQueue::Ticket ReadbackQueue::requestPixels(
+  const int32_t x,
+  const int32_t y,
+  const uint32_t width,
+  const uint32_t height,
+  const uint32_t format,
+  const uint32_t type,
+  const uint32_t pixelSize
+) {
+  const uint32_t row = (width * pixelSize + 3) & ~3u;
+
+  Readback *readback = reserve(row * height);
+  if (!readback) return 0;
+
+  // pack the pixels into the staging buffer instead of client memory
+  glAssert(glBindBuffer(GL_PIXEL_PACK_BUFFER, _id));
+  glAssert(glReadPixels(
+    x, y, width, height, format, type, (void *)(uintptr_t)readback->offset
+  ));
+  glAssert(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+
+  return fence(*readback);
+}
+
+void ReadbackQueue::release(const Ticket ticket) {
+  for (Readback &readback : _readbacks) {
+    if (readback.ticket == ticket) readback.released = true;
+  }
+
+  // staging ranges are handed back in request order
+  while (!_readbacks.empty() && _readbacks.front().released) {
+    const Readback &readback = _readbacks.front();
+    if (readback.fence) glAssert(glDeleteSync(readback.fence));
+
+    _used -= readback.padding + readback.size;
+    _readbacks.pop_front();
+  }
+
+  if (_readbacks.empty()) _head = 0;
+}
+
+const uint32_t ReadbackQueue::getUsedSize() const {
+  return _used;
+}
+
+void ReadbackQueue::destroy() {
+  if (!_id) return;
+
+  // release pending fences
+  for (const Readback &readback : _readbacks) {
+    if (readback.fence) glAssert(glDeleteSync(readback.fence));
+  }
+
+  _readbacks.clear();
+
+  // unmap & release the staging storage
+  if (hasDirectStateAccess()) {
+    glAssert(glUnmapNamedBuffer(_id));
+  } else {
+    glAssert(glBindBuffer(GL_COPY_WRITE_BUFFER, _id));
+    glAssert(glUnmapBuffer(GL_COPY_WRITE_BUFFER));
+  }
+
+  glAssert(glDeleteBuffers(1, &_id));
+
+  _data = nullptr;
+  _head = 0;
+  _used = 0;
+  _id = 0;
+}
+
+ReadbackQueue::Readback *ReadbackQueue::reserve(const uint32_t size) {
+  // align ranges so views can read any value type
+  uint32_t offset = (_head + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+  uint32_t padding = offset - _head;
+
+  // ranges must be contiguous, skip the end when it is too small
+  if (offset > _capacity || _capacity - offset < size) {
+    offset = 0;
+    padding = _capacity - _head;
+  }
+
+  if (_used + padding + size > _capacity) return nullptr;
+
+  _head = (offset + size) % _capacity;
+  _used += padding + size;
+
+  _readbacks.push_back({_next++, nullptr, offset, size, padding, false});
+
+  return &_readbacks.back();
+}
+
+ReadbackQueue::Ticket ReadbackQueue::fence(Readback &readback) {
+  glAssert(readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+  return readback.ticket;
+}
+
+const ReadbackQueue::Readback *
+ReadbackQueue::find(const Ticket ticket, const bool wait) {
+  for (Readback &readback : _readbacks) {
+    if (readback.ticket != ticket) continue;
+    if (readback.released) return nullptr;
+    if (!readback.fence) return &readback;
+
+    // poll or block, flushing so the fence is sure to be reached
+    GLenum status;
+    do {
+      status = glClientWaitSync(
+        readback.fence, GL_SYNC_FLUSH_COMMANDS_BIT, wait ? 1000000 : 0
+      );
+    } while (wait && status == GL_TIMEOUT_EXPIRED);
+
+    if (status == GL_TIMEOUT_EXPIRED) return nullptr;
+
+    // a failed wait leaves the copy in flight, keep the fence for destroy
+    if (status == GL_WAIT_FAILED) throw FenceWaitError();
+
+    glAssert(glDeleteSync(readback.fence));
+    readback.fence = nullptr;
+
+    return &readback;
+  }
+
+  return nullptr;
+}
+
+} // namespace stem
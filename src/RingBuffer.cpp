@@ -0,0 +1,15 @@
+#include <string>
+
+#include <stem/RingBuffer.hpp>
+
+namespace stem {
+
+BufferMapError::BufferMapError(const uint32_t id) {
+  _message = "Buffer " + std::to_string(id) + " could not be mapped";
+}
+
+FenceWaitError::FenceWaitError() {
+  _message = "Waiting for a gpu fence failed";
+}
+
+} // namespace stem
@@ -0,0 +1,232 @@
+#include <cstring>
+#include <utility>
+#include <algorithm>
+
+#include <stem/Error.hpp>
+#include <stem/RingBuffer.hpp>
+#include <stem/Capabilities.hpp>
+#include <stem/UploadQueue.hpp>
+
+namespace stem {
+
+UploadQueue::UploadQueue(const uint32_t capacity) : _capacity(capacity) {
+  // allocate & map the staging storage once
+  const GLbitfield flags =
+    GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+  if (hasDirectStateAccess()) {
+    glAssert(glCreateBuffers(1, &_id));
+    glAssert(glNamedBufferStorage(_id, capacity, nullptr, flags));
+    _data =
+      static_cast<uint8_t *>(glMapNamedBufferRange(_id, 0, capacity, flags));
+  } else {
+    glAssert(glGenBuffers(1, &_id));
+    glAssert(glBindBuffer(GL_COPY_READ_BUFFER, _id));
+
+    glAssert(glBufferStorage(GL_COPY_READ_BUFFER, capacity, nullptr, flags));
+    _data = static_cast<uint8_t *>(
+      glMapBufferRange(GL_COPY_READ_BUFFER, 0, capacity, flags)
+    );
+  }
+
+  // release the storage rather than staging through a null pointer
+  if (!_data) {
+    const uint32_t id = std::exchange(_id, 0);
+    glAssert(glDeleteBuffers(1, &id));
+    throw BufferMapError(id);
+  }
+}
+
+UploadQueue::UploadQueue(UploadQueue &&other) noexcept {
+  *this = std::move(other);
+}
+
+UploadQueue &UploadQueue::operator=(UploadQueue &&other) noexcept {
+  if (this == &other) return *this;
+
+  // release our own staging before taking the other one
+  destroy();
+
+  _id = std::exchange(other._id, 0);
+  _capacity = other._capacity;
+  _data = std::exchange(other._data, nullptr);
+  _head = other._head;
+  _used = other._used;
+  _next = other._next;
+  _staged = other._staged;
+  _resident = other._resident;
+  _pending = std::exchange(other._pending, {});
+  _batches = std::exchange(other._batches, {});
+
+  return *this;
+}
+
+UploadQueue::~UploadQueue() {
+  destroy();
+}
+
+UploadQueue::Ticket UploadQueue::enqueue(
+  const uint32_t buffer,
+  const uint32_t offset,
+  const void *data,
+  const uint32_t size
+) {
+  const Ticket ticket = _next++;
+
+  _pending.push_back(
+    {buffer, offset, static_cast<const uint8_t *>(data), size, ticket}
+  );
+
+  return ticket;
+}
+
+void UploadQueue::update(const uint32_t budget) {
+  // release staging space of completed copies first
+  retire(false);
+
+  const Ticket staged = _staged;
+  uint32_t consumed = 0;
+  uint32_t copied = 0;
+
+  while (!_pending.empty() && copied < budget) {
+    Upload &upload = _pending.front();
+
+    // empty uploads are staged as soon as they are reached
+    if (!upload.size) {
+      _staged = upload.ticket;
+      _pending.pop_front();
+      continue;
+    }
+
+    const uint32_t free = _capacity - _used;
+    const uint32_t end = _capacity - _head;
+    const uint32_t wanted = std::min(upload.size, budget - copied);
+
+    // skip the end of the staging buffer when the start has more room
+    if (end < wanted && free > end) {
+      _used += end;
+      consumed += end;
+      _head = 0;
+    }
+
+    // stage as much of the upload as fits
+    const uint32_t available =
+      std::min(_capacity - _head, _capacity - _used);
+    const uint32_t size = std::min(wanted, available);
+    if (!size) break;
+
+    std::memcpy(_data + _head, upload.data, size);
+    copy(upload.buffer, _head, upload.offset, size);
+
+    _head = (_head + size) % _capacity;
+    _used += size;
+    consumed += size;
+    copied += size;
+
+    upload.data += size;
+    upload.offset += size;
+    upload.size -= size;
+
+    if (upload.size) continue;
+
+    _staged = upload.ticket;
+    _pending.pop_front();
+  }
+
+  if (!consumed && staged == _staged) return;
+
+  // fence the issued copies
+  const GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  _batches.push_back({fence, consumed, _staged});
+}
+
+void UploadQueue::finish() {
+  while (!_pending.empty() || !_batches.empty()) {
+    update();
+    retire(true);
+  }
+}
+
+const bool UploadQueue::isResident(const Ticket ticket) const {
+  return ticket <= _resident;
+}
+
+const uint64_t UploadQueue::getPendingSize() const {
+  uint64_t size = 0;
+
+  for (const Upload &upload : _pending) {
+    size += upload.size;
+  }
+
+  return size;
+}
+
+void UploadQueue::destroy() {
+  if (!_id) return;
+
+  // release pending fences
+  for (const Batch &batch : _batches) {
+    glAssert(glDeleteSync(batch.fence));
+  }
+
+  _batches.clear();
+  _pending.clear();
+
+  // unmap & release the staging storage
+  if (hasDirectStateAccess()) {
+    glAssert(glUnmapNamedBuffer(_id));
+  } else {
+    glAssert(glBindBuffer(GL_COPY_READ_BUFFER, _id));
+    glAssert(glUnmapBuffer(GL_COPY_READ_BUFFER));
+  }
+
+  glAssert(glDeleteBuffers(1, &_id));
+
+  _data = nullptr;
+  _id = 0;
+}
+
+void UploadQueue::retire(const bool wait) {
+  while (!_batches.empty()) {
+    const Batch &batch = _batches.front();
+
+    // poll or block on the oldest batch
+    const GLenum status = glClientWaitSync(
+      batch.fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, wait ? 1000000 : 0
+    );
+
+    if (status == GL_TIMEOUT_EXPIRED) {
+      if (wait) continue;
+      break;
+    }
+
+    // a failed wait leaves the copies in flight, keep the staging range
+    if (status == GL_WAIT_FAILED) throw FenceWaitError();
+
+    glAssert(glDeleteSync(batch.fence));
+
+    _used -= batch.size;
+    _resident = batch.ticket;
+    _batches.pop_front();
+  }
+}
+
+void UploadQueue::copy(
+  const uint32_t buffer,
+  const uint32_t source,
+  const uint32_t offset,
+  const uint32_t size
+) const {
+  if (hasDirectStateAccess()) {
+    glAssert(glCopyNamedBufferSubData(_id, buffer, source, offset, size));
+    return;
+  }
+
+  glAssert(glBindBuffer(GL_COPY_READ_BUFFER, _id));
+  glAssert(glBindBuffer(GL_COPY_WRITE_BUFFER, buffer));
+  glAssert(glCopyBufferSubData(
+    GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, source, offset, size
+  ));
+}
+
+} // namespace stem
@@ -0,0 +1,180 @@
+#include <cstring>
+#include <algorithm>
+
+#include <stem/VertexLayout.hpp>
+
+namespace stem {
+
+namespace {
+
+/// @brief The number of vertices interleaved per block, keeping the block
+/// destination bytes in cache while every element is scattered into it
+constexpr uint32_t BLOCK_SIZE = 256;
+
+/// @brief Scatters fixed-size elements into strided vertices
+/// Compile-time sizes lower each copy to a single register move
+/// @param source The tightly packed element bytes
+/// @param target The first destination element byte
+/// @param count The number of elements to scatter
+/// @param stride The destination vertex stride
+/// @return void
+template <uint32_t Size>
+void scatter(
+  const std::byte *source,
+  uint8_t *target,
+  const uint32_t count,
+  const uint32_t stride
+) {
+  for (uint32_t i = 0; i < count; i++) {
+    std::memcpy(target, source, Size);
+    source += Size;
+    target += stride;
+  }
+}
+
+/// @brief Scatters elements of any size into strided vertices
+/// @param source The tightly packed element bytes
+/// @param target The first destination element byte
+/// @param count The number of elements to scatter
+/// @param size The element byte size
+/// @param stride The destination vertex stride
+/// @return void
+void scatter(
+  const std::byte *source,
+  uint8_t *target,
+  const uint32_t count,
+  const uint32_t size,
+  const uint32_t stride
+) {
+  switch (size) {
+  case 2: return scatter<2>(source, target, count, stride);
+  case 4: return scatter<4>(source, target, count, stride);
+  case 6: return scatter<6>(source, target, count, stride);
+  case 8: return scatter<8>(source, target, count, stride);
+  case 12: return scatter<12>(source, target, count, stride);
+  case 16: return scatter<16>(source, target, count, stride);
+  }
+
+  for (uint32_t i = 0; i < count; i++) {
+    std::memcpy(target + i * stride, source + i * size, size);
+  }
+}
+
+} // namespace
+
+VertexLayoutError::VertexLayoutError(
+  const std::string name,
+  const uint32_t count,
+  const uint32_t expected
+) {
+  _message = "Vertex element " + name + " has " + std::to_string(count) +
+             " values, expected " + std::to_string(expected);
+}
+
+VertexLayoutError::VertexLayoutError(
+  const std::string name,
+  const uint32_t size
+) {
+  _message = "Vertex element " + name + " has " + std::to_string(size) +
+             " bytes, not a whole number of values";
+}
+
+VertexLayoutError::VertexLayoutError(
+  const uint32_t sources,
+  const uint32_t elements
+) {
+  _message = "Vertex layout has " + std::to_string(elements) +
+             " elements, got " + std::to_string(sources) + " sources";
+}
+
+VertexLayout::VertexLayout(std::vector<Element> elements) :
+  _elements(std::move(elements)) {
+  // place elements on 4 bytes boundaries as gl vertex fetch expects
+  for (Element &element : _elements) {
+    element.offset = _stride;
+    _stride += (getSize(element) + 3) & ~3u;
+  }
+}
+
+std::vector<uint8_t> VertexLayout::interleave(
+  const std::vector<std::span<const std::byte>> &sources
+) const {
+  // every element reads exactly one source
+  const size_t elements = _elements.size();
+  if (sources.size() != elements) {
+    throw VertexLayoutError(sources.size(), elements);
+  }
+
+  if (!elements) return {};
+
+  // every source must hold whole values for the same number of vertices
+  const uint32_t count = sources[0].size() / getSize(_elements[0]);
+
+  for (size_t i = 0; i < elements; i++) {
+    const Element &element = _elements[i];
+    const uint32_t bytes = sources[i].size();
+
+    if (bytes % getSize(element)) throw VertexLayoutError(element.name, bytes);
+
+    const uint32_t size = bytes / getSize(element);
+    if (size != count) throw VertexLayoutError(element.name, size, count);
+  }
+
+  // zero initialization clears the alignment padding
+  std::vector<uint8_t> vertices(count * _stride);
+
+  // scatter every element one block of vertices at a time
+  for (uint32_t first = 0; first < count; first += BLOCK_SIZE) {
+    const uint32_t block = std::min(BLOCK_SIZE, count - first);
+
+    for (size_t i = 0; i < elements; i++) {
+      const Element &element = _elements[i];
+      const uint32_t size = getSize(element);
+
+      scatter(
+        sources[i].data() + first * size,
+        vertices.data() + first * _stride + element.offset,
+        block,
+        size,
+        _stride
+      );
+    }
+  }
+
+  return vertices;
+}
+
+const std::vector<VertexLayout::Element> &VertexLayout::getElements() const {
+  return _elements;
+}
+
+const uint32_t VertexLayout::getStride() const {
+  return _stride;
+}
+
+const uint32_t VertexLayout::getSize(const Element &element) {
+  switch (element.type) {
+  // packed types hold every component in a single value
+  case GL_INT_2_10_10_10_REV:
+  case GL_UNSIGNED_INT_2_10_10_10_REV:
+  case GL_UNSIGNED_INT_10F_11F_11F_REV:
+    return 4;
+
+  case GL_BYTE:
+  case GL_UNSIGNED_BYTE:
+    return element.size;
+
+  case GL_SHORT:
+  case GL_UNSIGNED_SHORT:
+  case GL_HALF_FLOAT:
+    return element.size * 2;
+
+  case GL_DOUBLE:
+    return element.size * 8;
+
+  default:
+    return element.size * 4;
+  }
+}
+
+} // namespace stem
@@ -0,0 +1,46 @@
+#include <vector>
+#include <catch.hpp>
+#include <stem/Bounds.hpp>
+
+TEST_CASE("stem::computeBounds", "[core]") {
+  SECTION("empty positions are zeroed") {
+    const auto bounds = stem::computeBounds({});
+
+    REQUIRE(bounds.radius == 0);
+    REQUIRE(bounds.min[0] == 0);
+  }
+
+  // odd counts cover the avx, sse & scalar paths of every stride
+  for (const uint32_t stride : {3u, 4u, 5u, 8u, 17u}) {
+    SECTION("stride " + std::to_string(stride)) {
+      std::vector<float> positions;
+
+      for (uint32_t vertex = 0; vertex < 37; vertex++) {
+        positions.push_back(vertex == 13 ? -20.f : (float)vertex);
+        positions.push_back(vertex == 29 ? 50.f : 1.f);
+        positions.push_back(-(float)vertex);
+
+        // padding values must never leak into the bounds
+        if (vertex < 36) positions.resize(positions.size() + stride - 3, 1e6f);
+      }
+
+      const auto bounds = stem::computeBounds(positions, stride);
+
+      REQUIRE(bounds.min[0] == -20);
+      REQUIRE(bounds.min[1] == 1);
+      REQUIRE(bounds.min[2] == -36);
+      REQUIRE(bounds.max[0] == 36);
+      REQUIRE(bounds.max[1] == 50);
+      REQUIRE(bounds.max[2] == 0);
+      REQUIRE(bounds.center[0] == 8);
+      REQUIRE(bounds.center[1] == 25.5f);
+      REQUIRE(bounds.center[2] == -18);
+
+      for (uint32_t vertex = 0; vertex < 37; vertex++) {
+        const float *p = &positions[vertex * stride];
+        const float x = p[0] - 8, y = p[1] - 25.5f, z = p[2] + 18;
+        REQUIRE(x * x + y * y + z * z <= bounds.radius * bounds.radius + 1e-3f);
+      }
+    }
+  }
+}
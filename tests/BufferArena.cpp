@@ -0,0 +1,119 @@
+#include <memory>
+#include <catch.hpp>
+#include <stem/Buffer.hpp>
+
+TEST_CASE("stem::BufferArena", "[core]") {
+  // three 64 bytes ranges fill a page exactly
+  stem::BufferArena arena(192);
+  const std::vector<float> values(16, 1.f);
+
+  stem::FloatBuffer first(arena, values);
+  stem::FloatBuffer second(arena, values);
+  stem::FloatBuffer third(arena, values);
+
+  SECTION("allocate: ranges are packed in a single page") {
+    REQUIRE(arena.getPageCount() == 1);
+    REQUIRE(arena.getUsedSize() == 192);
+    REQUIRE(first.getOffset() == 0);
+    REQUIRE(second.getOffset() == 64);
+    REQUIRE(third.getOffset() == 128);
+  }
+
+  SECTION("defragment: compact pages are left untouched") {
+    const uint32_t id = first.getId();
+    const uint64_t generation = stem::BufferArena::getGeneration();
+
+    arena.defragment();
+
+    REQUIRE(first.getId() == id);
+    REQUIRE(stem::BufferArena::getGeneration() == generation);
+  }
+
+  SECTION("defragment: a single free block between ranges is compacted") {
+    second.destroy();
+
+    const uint32_t id = third.getId();
+    arena.defragment();
+
+    REQUIRE(third.getId() != id);
+    REQUIRE(first.getId() == third.getId());
+    REQUIRE(first.getOffset() == 0);
+    REQUIRE(third.getOffset() == 64);
+  }
+
+  SECTION("defragment: notifies the hook of every moved range") {
+    second.destroy();
+
+    std::vector<std::pair<uint32_t, uint32_t>> moves;
+    arena.defragment([&](const auto &from, const auto &to) {
+      moves.push_back({from.offset, to.offset});
+    });
+
+    REQUIRE(moves.size() == 2);
+    REQUIRE(moves[0] == std::pair<uint32_t, uint32_t>(0, 0));
+    REQUIRE(moves[1] == std::pair<uint32_t, uint32_t>(128, 64));
+  }
+
+  SECTION("destroy: frees the moved range after a defragment") {
+    stem::BufferArena large(1024);
+    stem::FloatBuffer a(large, values);
+    stem::FloatBuffer b(large, values);
+    stem::FloatBuffer c(large, values);
+    stem::FloatBuffer d(large, values);
+
+    b.destroy();
+    large.defragment();
+
+    REQUIRE(c.getOffset() == 64);
+    REQUIRE(d.getOffset() == 128);
+
+    // the stale offset of c now belongs to d & must stay live
+    c.destroy();
+    REQUIRE(large.getUsedSize() == 128);
+
+    stem::FloatBuffer e(large, values);
+    REQUIRE(e.getOffset() == 64);
+    REQUIRE(d.getOffset() == 128);
+    REQUIRE(large.getUsedSize() == 192);
+  }
+
+  SECTION("destroy: detaches buffers outliving their arena") {
+    auto scoped = std::make_unique<stem::BufferArena>(256);
+    stem::FloatBuffer survivor(*scoped, values);
+    REQUIRE(survivor.getId() != 0);
+
+    scoped.reset();
+
+    REQUIRE(survivor.getId() == 0);
+    REQUIRE(survivor.getOffset() == 0);
+    REQUIRE_NOTHROW(survivor.destroy());
+  }
+
+  SECTION("destroy: pages can be allocated again after a destroy") {
+    arena.destroy();
+
+    REQUIRE(first.getId() == 0);
+    REQUIRE(arena.getUsedSize() == 0);
+
+    stem::FloatBuffer fresh(arena, values);
+    REQUIRE(fresh.getId() != 0);
+    REQUIRE(arena.getUsedSize() == 64);
+
+    // detached buffers never free the ranges of the new pages
+    first.destroy();
+    REQUIRE(arena.getUsedSize() == 64);
+  }
+
+  SECTION("move: keeps reading the relocated range") {
+    second.destroy();
+
+    stem::FloatBuffer moved = std::move(third);
+    arena.defragment();
+
+    REQUIRE(moved.getOffset() == 64);
+    REQUIRE(third.getId() == 0);
+
+    moved.destroy();
+    REQUIRE(arena.getUsedSize() == 64);
+  }
+}
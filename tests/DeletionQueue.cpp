@@ -0,0 +1,91 @@
+#include <vector>
+#include <catch.hpp>
+#include <stem/Buffer.hpp>
+#include <stem/RingBuffer.hpp>
+#include <stem/DeletionQueue.hpp>
+
+#if ENABLE_GL_TESTS
+#include "GLOverride.hpp"
+#endif
+
+TEST_CASE("stem::DeletionQueue", "[core]") {
+  SECTION("getSizeClass: rounds up to quarter power of two steps") {
+    REQUIRE(stem::DeletionQueue::getSizeClass(0) == 256);
+    REQUIRE(stem::DeletionQueue::getSizeClass(256) == 256);
+    REQUIRE(stem::DeletionQueue::getSizeClass(257) == 320);
+    REQUIRE(stem::DeletionQueue::getSizeClass(512) == 512);
+    REQUIRE(stem::DeletionQueue::getSizeClass(513) == 640);
+    REQUIRE(stem::DeletionQueue::getSizeClass(70000) == 81920);
+  }
+
+  SECTION("makeCurrent: receives destroyed objects until destructed") {
+    {
+      stem::DeletionQueue queue;
+      queue.makeCurrent();
+      REQUIRE(stem::DeletionQueue::getCurrent() == &queue);
+    }
+
+    REQUIRE(stem::DeletionQueue::getCurrent() == nullptr);
+  }
+
+  SECTION("move: keeps the current queue") {
+    stem::DeletionQueue queue;
+    queue.makeCurrent();
+
+    stem::DeletionQueue moved = std::move(queue);
+    REQUIRE(stem::DeletionQueue::getCurrent() == &moved);
+  }
+
+#if ENABLE_GL_TESTS
+  SECTION("update: recycles buffers once their frame fence is signaled") {
+    stem::DeletionQueue queue;
+    queue.makeCurrent();
+
+    // 100 floats are pooled under the 384 bytes class
+    stem::FloatBuffer buffer(std::vector<float>(100, 1.f));
+    const uint32_t id = buffer.getId();
+    buffer.destroy();
+
+    {
+      GLOverride wait(glad_glClientWaitSync, expireWait);
+      queue.update();
+      REQUIRE(queue.getPoolSize() == 0);
+    }
+
+    queue.update();
+    REQUIRE(queue.getPoolSize() == 400);
+
+    // 90 floats round up to the same class
+    stem::FloatBuffer recycled(std::vector<float>(90, 2.f));
+    REQUIRE(recycled.getId() == id);
+    REQUIRE(queue.getPoolSize() == 0);
+  }
+
+  SECTION("update: deletes immutable buffers instead of pooling them") {
+    stem::DeletionQueue queue;
+    queue.makeCurrent();
+
+    stem::FloatBuffer buffer(
+      std::vector<float>(100, 1.f),
+      stem::FloatBuffer::Static,
+      stem::FloatBuffer::None
+    );
+    buffer.destroy();
+
+    queue.finish();
+    REQUIRE(queue.getPoolSize() == 0);
+  }
+
+  SECTION("update: throws when the fence wait fails") {
+    stem::DeletionQueue queue;
+    queue.makeCurrent();
+
+    stem::FloatBuffer buffer(std::vector<float>(100, 1.f));
+    buffer.destroy();
+
+    GLOverride wait(glad_glClientWaitSync, failWait);
+    REQUIRE_THROWS_AS(queue.update(), stem::FenceWaitError);
+    REQUIRE(queue.getPoolSize() == 0);
+  }
+#endif
+}
@@ -0,0 +1,49 @@
+#include <catch.hpp>
+#include <stem/DirtyRanges.hpp>
+
+TEST_CASE("stem::DirtyRanges", "[core]") {
+  stem::DirtyRanges ranges;
+  const uint8_t bytes[] = {1, 2, 3, 4, 5, 6, 7, 8};
+
+  SECTION("write: disjoint ranges stay separate") {
+    ranges.write(0, bytes, 2);
+    ranges.write(8, bytes, 2);
+    REQUIRE(ranges.getRanges().size() == 2);
+  }
+
+  SECTION("write: adjacent ranges are merged") {
+    ranges.write(0, bytes, 4);
+    ranges.write(4, bytes + 4, 4);
+    REQUIRE(ranges.getRanges().size() == 1);
+    REQUIRE(ranges.getRanges().at(0) == std::vector<uint8_t>(bytes, bytes + 8));
+  }
+
+  SECTION("write: overlapping ranges are merged with latest bytes") {
+    ranges.write(2, bytes, 4);
+    ranges.write(10, bytes, 2);
+    ranges.write(0, bytes + 4, 4);
+    ranges.write(5, bytes, 6);
+
+    REQUIRE(ranges.getRanges().size() == 1);
+    REQUIRE(
+      ranges.getRanges().at(0) ==
+      std::vector<uint8_t>({5, 6, 7, 8, 3, 1, 2, 3, 4, 5, 6, 2})
+    );
+  }
+
+  SECTION("write: writes inside a range are copied in place") {
+    ranges.write(0, bytes, 8);
+    ranges.write(2, bytes, 2);
+    REQUIRE(ranges.getRanges().size() == 1);
+    REQUIRE(
+      ranges.getRanges().at(0) ==
+      std::vector<uint8_t>({1, 2, 1, 2, 5, 6, 7, 8})
+    );
+  }
+
+  SECTION("clear: no pending ranges") {
+    ranges.write(0, bytes, 8);
+    ranges.clear();
+    REQUIRE(ranges.empty());
+  }
+}
@@ -0,0 +1,88 @@
+#include <vector>
+#include <catch.hpp>
+#include <stem/DrawBatch.hpp>
+
+TEST_CASE("stem::DrawBatch", "[core]") {
+  stem::BufferArena arena(4096);
+  const std::vector<float> positions(9, 0.f);
+  const std::vector<uint32_t> indices = {0, 1, 2};
+
+  // sub-allocate both meshes from the same arena page
+  stem::FloatBuffer firstPositions(arena, positions, 12);
+  stem::IndexBuffer firstIndices(arena, indices);
+  stem::FloatBuffer secondPositions(arena, positions, 12);
+  stem::IndexBuffer secondIndices(arena, indices);
+
+  const uint32_t shift =
+    (secondPositions.getOffset() - firstPositions.getOffset()) / 12;
+  const uint32_t baseIndex = firstIndices.getOffset() / 4;
+  const uint32_t firstIndex = secondIndices.getOffset() / 4;
+
+  stem::Geometry first;
+  first.setAttribute({
+    .name = "position",
+    .size = 3,
+    .buffer = std::move(firstPositions),
+  });
+  first.setIndex(std::move(firstIndices));
+
+  stem::Geometry second;
+  second.setAttribute({
+    .name = "position",
+    .size = 3,
+    .buffer = std::move(secondPositions),
+  });
+  second.setIndex(std::move(secondIndices));
+  second.setRange(1, 2);
+
+  stem::Geometry standalone;
+  standalone.setAttribute({
+    .name = "position",
+    .size = 3,
+    .buffer = stem::FloatBuffer(positions),
+  });
+
+  SECTION("getIndirectCommand: shared buffers become index & vertex offsets") {
+    const auto command = second.getIndirectCommand(first, 4, 2);
+
+    REQUIRE(command.has_value());
+    REQUIRE(command->count == 2);
+    REQUIRE(command->instanceCount == 4);
+    REQUIRE(command->firstIndex == firstIndex + 1);
+    REQUIRE(command->baseVertex == (int32_t)shift);
+    REQUIRE(command->baseInstance == 2);
+  }
+
+  SECTION("getIndirectCommand: the base geometry keeps its own vertices") {
+    const auto command = first.getIndirectCommand(first);
+
+    REQUIRE(command.has_value());
+    REQUIRE(command->firstIndex == baseIndex);
+    REQUIRE(command->baseVertex == 0);
+  }
+
+  SECTION("getIndirectCommand: non indexed or separate buffers are rejected") {
+    REQUIRE_FALSE(standalone.getIndirectCommand(first).has_value());
+    REQUIRE_FALSE(first.getIndirectCommand(standalone).has_value());
+
+    standalone.setIndex(stem::IndexBuffer(indices));
+    REQUIRE_FALSE(standalone.getIndirectCommand(first).has_value());
+  }
+
+  SECTION("add: rejected geometries do not anchor the batch") {
+    stem::DrawBatch batch(4);
+
+    REQUIRE_FALSE(batch.add(standalone));
+    REQUIRE(batch.add(first));
+    REQUIRE(batch.add(second));
+    REQUIRE(batch.getCount() == 2);
+  }
+
+  SECTION("drawIndirect: non indexed geometries throw") {
+    const stem::Program program;
+
+    REQUIRE_THROWS_AS(
+      standalone.drawIndirect(program, 0, 1), stem::IndirectDrawError
+    );
+  }
+}
@@ -0,0 +1,48 @@
+#include <catch.hpp>
+#include <stem/FreeList.hpp>
+
+TEST_CASE("stem::FreeList", "[core]") {
+  stem::FreeList list(1024);
+
+  SECTION("allocate: consecutive ranges") {
+    REQUIRE(list.allocate(100) == 0u);
+    REQUIRE(list.allocate(100) == 100u);
+    REQUIRE(list.getFreeSize() == 824);
+  }
+
+  SECTION("allocate: aligned offsets") {
+    REQUIRE(list.allocate(3) == 0u);
+    REQUIRE(list.allocate(16, 16) == 16u);
+    REQUIRE(list.getFreeSize() == 1024 - 19);
+  }
+
+  SECTION("allocate: too large ranges fail") {
+    REQUIRE_FALSE(list.allocate(2048));
+  }
+
+  SECTION("allocate: best fitting block is reused") {
+    const uint32_t a = list.allocate(64).value();
+    list.allocate(32);
+    const uint32_t b = list.allocate(16).value();
+    list.allocate(32);
+
+    list.free(a, 64);
+    list.free(b, 16);
+
+    REQUIRE(list.allocate(16) == b);
+  }
+
+  SECTION("free: neighbours are merged") {
+    const uint32_t a = list.allocate(100).value();
+    const uint32_t b = list.allocate(100).value();
+    const uint32_t c = list.allocate(100).value();
+
+    list.free(a, 100);
+    list.free(c, 100);
+    REQUIRE(list.getBlockCount() == 2);
+
+    list.free(b, 100);
+    REQUIRE(list.getBlockCount() == 1);
+    REQUIRE(list.getLargestBlock() == 1024);
+  }
+}
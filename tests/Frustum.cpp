@@ -0,0 +1,69 @@
+#include <random>
+#include <vector>
+#include <catch.hpp>
+#include <stem/Frustum.hpp>
+
+TEST_CASE("stem::Frustum", "[core]") {
+  // orthographic projection of the [-1, 1] cube, column-major
+  const float identity[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+  const stem::Frustum frustum(identity);
+
+  SECTION("planes face inside") {
+    const auto planes = frustum.getPlanes();
+
+    REQUIRE(planes[0] == 1);
+    REQUIRE(planes[3] == 1);
+    REQUIRE(planes[4] == -1);
+    REQUIRE(planes[7] == 1);
+  }
+
+  SECTION("intersects: inside, straddling & outside boxes") {
+    REQUIRE(frustum.intersects({{-.5f, -.5f, -.5f}, {.5f, .5f, .5f}}));
+    REQUIRE(frustum.intersects({{.5f, .5f, .5f}, {3, 3, 3}}));
+    REQUIRE_FALSE(frustum.intersects({{1.5f, 0, 0}, {2, 1, 1}}));
+    REQUIRE_FALSE(frustum.intersects({{0, 0, -4}, {1, 1, -2}}));
+  }
+
+  SECTION("cull: matches intersects for every box") {
+    std::mt19937 random(3);
+    std::uniform_real_distribution<float> position(-3, 3), size(0, 1);
+
+    stem::BoundsList list;
+    std::vector<stem::Bounds> boxes;
+
+    // leave a partial block for the scalar tail
+    for (uint32_t index = 0; index < 203; index++) {
+      stem::Bounds box;
+      for (uint32_t axis = 0; axis < 3; axis++) {
+        box.min[axis] = position(random);
+        box.max[axis] = box.min[axis] + size(random);
+      }
+
+      boxes.push_back(box);
+      list.push(box);
+    }
+
+    std::vector<uint8_t> mask((list.getCount() + 7) / 8, 0xFF);
+    frustum.cull(list, mask);
+
+    uint32_t visible = 0;
+    for (uint32_t index = 0; index < boxes.size(); index++) {
+      const bool bit = mask[index / 8] >> (index % 8) & 1;
+      REQUIRE(bit == frustum.intersects(boxes[index]));
+      visible += bit;
+    }
+
+    REQUIRE(visible > 0);
+    REQUIRE(visible < boxes.size());
+  }
+
+  SECTION("cull: short masks throw") {
+    stem::BoundsList list;
+    for (uint32_t index = 0; index < 9; index++) {
+      list.push({{0, 0, 0}, {1, 1, 1}});
+    }
+
+    std::vector<uint8_t> mask(1);
+    REQUIRE_THROWS_AS(frustum.cull(list, mask), stem::CullMaskError);
+  }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <utility>
+#include <glad/gl.h>
+
+/// @brief Swaps a loaded gl function for a test double until destructed
+template <typename Function>
+class GLOverride {
+public:
+  /// @brief GLOverride constructor
+  /// @param function The glad function pointer to swap
+  /// @param replacement The test double
+  /// @return GLOverride
+  GLOverride(Function &function, const Function replacement) :
+    _function(function), _original(std::exchange(function, replacement)) {}
+
+  /// @brief GLOverride destructor restoring the loaded function
+  ~GLOverride() {
+    _function = _original;
+  }
+
+private:
+  /// @brief The swapped glad function pointer
+  Function &_function;
+
+  /// @brief The loaded function
+  Function _original;
+};
+
+/// @brief Fails every fence wait
+inline GLenum GLAD_API_PTR failWait(GLsync, GLbitfield, GLuint64) {
+  return GL_WAIT_FAILED;
+}
+
+/// @brief Never signals a fence
+inline GLenum GLAD_API_PTR expireWait(GLsync, GLbitfield, GLuint64) {
+  return GL_TIMEOUT_EXPIRED;
+}
+
+/// @brief Fails every direct state access buffer mapping
+inline void *GLAD_API_PTR
+failNamedMap(GLuint, GLintptr, GLsizeiptr, GLbitfield) {
+  return nullptr;
+}
+
+/// @brief Fails every bound buffer mapping
+inline void *GLAD_API_PTR failMap(GLenum, GLintptr, GLsizeiptr, GLbitfield) {
+  return nullptr;
+}
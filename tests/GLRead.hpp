@@ -0,0 +1,27 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <glad/gl.h>
+
+/// @brief Reads values of a gl buffer back into client memory
+/// @param buffer The gl buffer identifier
+/// @param offset The byte offset of the first value
+/// @param count The number of values to read
+/// @return The read values
+template <typename ValueType>
+std::vector<ValueType> readBuffer(
+  const uint32_t buffer,
+  const uint32_t offset,
+  const uint32_t count
+) {
+  std::vector<ValueType> values(count);
+
+  glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+  glGetBufferSubData(
+    GL_COPY_READ_BUFFER, offset, count * sizeof(ValueType), values.data()
+  );
+  glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+  return values;
+}
@@ -0,0 +1,121 @@
+#include <vector>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <catch.hpp>
+#include <stem/GeometryFile.hpp>
+
+TEST_CASE("stem::GeometryFile", "[core]") {
+  const std::string path =
+    (std::filesystem::temp_directory_path() / "stem-test.stemgeo").string();
+
+  const stem::VertexLayout layout({
+    {.name = "position", .size = 3},
+    {.name = "color", .size = 4, .type = GL_UNSIGNED_BYTE, .normalized = true},
+  });
+
+  const std::vector<float> positions = {0, 0, 0, 4, -2, 1, 1, 2, -3};
+  const std::vector<uint8_t> colors(12, 255);
+  const std::vector<uint8_t> vertices = layout.interleave(positions, colors);
+  const std::vector<uint32_t> indices = {0, 1, 2, 2, 1, 0};
+
+  SECTION("write & read back without conversion") {
+    stem::writeGeometryFile(path, layout, vertices, indices);
+    const stem::GeometryFile file(path);
+
+    const auto &header = file.getHeader();
+    REQUIRE(header.vertexCount == 3);
+    REQUIRE(header.indexType == GL_UNSIGNED_BYTE);
+    REQUIRE(header.verticesOffset % 16 == 0);
+    REQUIRE(header.bounds.min[0] == 0);
+    REQUIRE(header.bounds.max[0] == 4);
+    REQUIRE(header.bounds.min[2] == -3);
+    REQUIRE(header.bounded);
+
+    const auto read = file.getLayout();
+    REQUIRE(read.getStride() == layout.getStride());
+    REQUIRE(read.getElements()[1].name == "color");
+    REQUIRE(read.getElements()[1].type == GL_UNSIGNED_BYTE);
+    REQUIRE(read.getElements()[1].normalized);
+
+    const auto bytes = file.getVertices();
+    REQUIRE(std::equal(bytes.begin(), bytes.end(), vertices.begin()));
+
+    const auto narrow = file.getIndices();
+    REQUIRE(narrow.size() == indices.size());
+    REQUIRE((uint8_t)narrow[3] == 2);
+  }
+
+  SECTION("wide indices keep their width") {
+    const std::vector<uint32_t> wide = {0, 1, 70000};
+    stem::writeGeometryFile(path, layout, vertices, wide);
+    const stem::GeometryFile file(path);
+
+    uint32_t last;
+    std::memcpy(&last, file.getIndices().data() + 8, 4);
+
+    REQUIRE(file.getHeader().indexType == GL_UNSIGNED_INT);
+    REQUIRE(last == 70000);
+  }
+
+  SECTION("bounds are only computed for float xyz positions") {
+    const stem::VertexLayout flat({{.name = "position", .size = 2}});
+    const std::vector<float> uvs = {0, 0, 4, -2, 1, 2};
+
+    stem::writeGeometryFile(path, flat, flat.interleave(uvs));
+    const stem::GeometryFile file(path);
+
+    REQUIRE_FALSE(file.getHeader().bounded);
+  }
+
+  SECTION("corrupted element records are rejected") {
+    const auto corrupt = [&](const size_t offset, const uint32_t value) {
+      stem::writeGeometryFile(path, layout, vertices, indices);
+      const auto mode = std::ios::binary | std::ios::in | std::ios::out;
+      std::fstream stream(path, mode);
+
+      stem::GeometryFileHeader header;
+      stream.read((char *)&header, sizeof(header));
+
+      // patch a field of the second record, the color element
+      stream.seekp(header.elementsOffset + sizeof(stem::GeometryFileElement) +
+                   offset);
+      stream.write((const char *)&value, sizeof(value));
+    };
+
+    corrupt(offsetof(stem::GeometryFileElement, size), 40);
+    REQUIRE_THROWS_AS(stem::GeometryFile(path), stem::GeometryFileError);
+
+    corrupt(offsetof(stem::GeometryFileElement, size), -1);
+    REQUIRE_THROWS_AS(stem::GeometryFile(path), stem::GeometryFileError);
+
+    corrupt(offsetof(stem::GeometryFileElement, type), 0x1234);
+    REQUIRE_THROWS_AS(stem::GeometryFile(path), stem::GeometryFileError);
+
+    corrupt(offsetof(stem::GeometryFileElement, offset), 4);
+    REQUIRE_THROWS_AS(stem::GeometryFile(path), stem::GeometryFileError);
+
+    // a wider color no longer matches the stored stride
+    corrupt(offsetof(stem::GeometryFileElement, type), GL_FLOAT);
+    REQUIRE_THROWS_AS(stem::GeometryFile(path), stem::GeometryFileError);
+
+    corrupt(offsetof(stem::GeometryFileElement, size), 4);
+    REQUIRE_NOTHROW(stem::GeometryFile(path));
+  }
+
+  SECTION("invalid files are rejected") {
+    REQUIRE_THROWS_AS(
+      stem::GeometryFile(path + ".missing"), stem::GeometryFileError
+    );
+
+    stem::writeGeometryFile(path, layout, vertices, indices);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+    REQUIRE_THROWS_AS(stem::GeometryFile(path), stem::GeometryFileError);
+
+    std::ofstream(path, std::ios::binary) << "STEMOBJ" << std::string(200, 0);
+    REQUIRE_THROWS_AS(stem::GeometryFile(path), stem::GeometryFileError);
+  }
+
+  std::filesystem::remove(path);
+}
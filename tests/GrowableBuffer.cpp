@@ -0,0 +1,72 @@
+#include <vector>
+#include <numeric>
+#include <catch.hpp>
+#include <stem/GrowableBuffer.hpp>
+
+#include "GLRead.hpp"
+
+TEST_CASE("stem::GrowableBuffer", "[core]") {
+  stem::FloatGrowableBuffer buffer(4);
+
+  std::vector<float> values(40);
+  std::iota(values.begin(), values.end(), 1.f);
+
+  SECTION("append: grows geometrically & keeps the appended values") {
+    std::vector<uint32_t> ids = {buffer.getId()};
+    std::vector<uint32_t> capacities = {buffer.getCapacity()};
+
+    // 10 appends of 4 values grow the storage from 4 to 64 values
+    for (uint32_t first = 0; first < values.size(); first += 4) {
+      const std::span<const float> chunk(values.data() + first, 4);
+      REQUIRE(buffer.append(chunk) == first);
+
+      if (buffer.getCapacity() != capacities.back()) {
+        REQUIRE(buffer.getId() != ids.back());
+        ids.push_back(buffer.getId());
+        capacities.push_back(buffer.getCapacity());
+      }
+    }
+
+    REQUIRE(capacities == std::vector<uint32_t>({4, 8, 16, 32, 64}));
+    REQUIRE(buffer.getCount() == 40);
+
+    buffer.flush();
+    REQUIRE(readBuffer<float>(buffer.getId(), 0, 40) == values);
+  }
+
+  SECTION("reserve: copies unflushed values before growing") {
+    buffer.append(std::span<const float>(values).first(3));
+    buffer.reserve(100);
+
+    REQUIRE(buffer.getCapacity() == 100);
+
+    buffer.append(std::span<const float>(values).subspan(3, 2));
+    buffer.flush();
+
+    REQUIRE(
+      readBuffer<float>(buffer.getId(), 0, 5) ==
+      std::vector<float>(values.begin(), values.begin() + 5)
+    );
+  }
+
+  SECTION("update: rejects values past the appended ones") {
+    buffer.append(std::span<const float>(values).first(2));
+
+    REQUIRE_THROWS_AS(
+      buffer.update(1, std::span<const float>(values).first(2)),
+      stem::BufferRangeError
+    );
+  }
+
+  SECTION("clear: keeps the storage") {
+    buffer.append(std::span<const float>(values).first(8));
+
+    const uint32_t id = buffer.getId();
+    buffer.clear();
+
+    REQUIRE(buffer.getCount() == 0);
+    REQUIRE(buffer.getId() == id);
+    REQUIRE(buffer.append(std::span<const float>(values).first(8)) == 0);
+    REQUIRE(buffer.getId() == id);
+  }
+}
@@ -0,0 +1,171 @@
+#include <vector>
+#include <catch.hpp>
+#include <stem/Geometry.hpp>
+#include <stem/InstanceBuilder.hpp>
+
+#include "GLRead.hpp"
+#include "GLOverride.hpp"
+
+namespace {
+
+/// @brief Defines an instance with a normal matrix & a translation
+struct Instance {
+  /// @brief The column-major normal matrix
+  float normal[9];
+
+  /// @brief The translation
+  float offset[3];
+};
+
+/// @brief Stores an attribute format set while binding a vertex array
+struct Format {
+  /// @brief The attribute location
+  uint32_t attribute;
+
+  /// @brief The number of components
+  int32_t size;
+
+  /// @brief The byte offset relative to the binding or buffer start
+  uintptr_t offset;
+};
+
+/// @brief The attribute formats set since the last clear
+std::vector<Format> formats;
+
+/// @brief The loaded attribute format functions
+PFNGLVERTEXARRAYATTRIBFORMATPROC loadedAttribFormat = nullptr;
+PFNGLVERTEXATTRIBPOINTERPROC loadedAttribPointer = nullptr;
+
+/// @brief Records direct state access attribute formats
+void GLAD_API_PTR recordAttribFormat(
+  GLuint id,
+  GLuint attribute,
+  GLint size,
+  GLenum type,
+  GLboolean normalized,
+  GLuint offset
+) {
+  formats.push_back({attribute, size, offset});
+  loadedAttribFormat(id, attribute, size, type, normalized, offset);
+}
+
+/// @brief Records bound attribute pointers
+void GLAD_API_PTR recordAttribPointer(
+  GLuint attribute,
+  GLint size,
+  GLenum type,
+  GLboolean normalized,
+  GLsizei stride,
+  const void *pointer
+) {
+  formats.push_back({attribute, size, (uintptr_t)pointer});
+  loadedAttribPointer(attribute, size, type, normalized, stride, pointer);
+}
+
+} // namespace
+
+TEST_CASE("stem::InstanceBuilder", "[core]") {
+  // three frame slices of 4 instances
+  stem::InstanceBuilder<Instance> builder(4, 3);
+
+  SECTION("getBaseInstance: selects the slice holding the written instances") {
+    for (uint32_t frame = 0; frame < 5; frame++) {
+      builder.begin();
+
+      for (uint32_t i = 0; i < 2; i++) {
+        REQUIRE(builder.push({.offset = {(float)frame, (float)i, 0.f}}));
+      }
+
+      const uint32_t base = builder.getBaseInstance();
+      REQUIRE(base == frame % 3 * 4);
+
+      const std::vector<Instance> instances =
+        readBuffer<Instance>(builder.getId(), base * sizeof(Instance), 2);
+
+      for (uint32_t i = 0; i < 2; i++) {
+        REQUIRE(instances[i].offset[0] == (float)frame);
+        REQUIRE(instances[i].offset[1] == (float)i);
+      }
+
+      builder.end();
+    }
+  }
+
+  SECTION("push: rejects instances past the slice capacity") {
+    builder.begin();
+
+    for (uint32_t i = 0; i < 4; i++) {
+      REQUIRE(builder.push({}));
+    }
+
+    REQUIRE_FALSE(builder.push({}));
+    REQUIRE(builder.getCount() == 4);
+
+    builder.end();
+  }
+
+  SECTION("setInstances: binds one tightly packed location per mat3 column") {
+    stem::Program program({
+      .vertex = "#version 330 core\n"
+                "in vec3 position;\n"
+                "in mat3 normalMatrix;\n"
+                "out vec3 normal;\n"
+                "void main() {\n"
+                "  normal = normalMatrix * position;\n"
+                "  gl_Position = vec4(position, 1.0);\n"
+                "}\n",
+      .fragment = "#version 330 core\n"
+                  "in vec3 normal;\n"
+                  "out vec4 color;\n"
+                  "void main() { color = vec4(normal, 1.0); }\n",
+    });
+
+    stem::Geometry geometry;
+    geometry.setAttribute({
+      .name = "position",
+      .size = 3,
+      .buffer = stem::FloatBuffer(std::vector<float>(9, 0.f)),
+    });
+    geometry.setInstances({
+      .layout = stem::VertexLayout({
+        {.name = "normalMatrix", .size = 9},
+        {.name = "offset", .size = 3},
+      }),
+      .buffer = builder.getId(),
+    });
+
+    builder.begin();
+    builder.push({});
+
+    formats.clear();
+    loadedAttribFormat = glad_glVertexArrayAttribFormat;
+    loadedAttribPointer = glad_glVertexAttribPointer;
+
+    {
+      GLOverride format(glad_glVertexArrayAttribFormat, recordAttribFormat);
+      GLOverride pointer(glad_glVertexAttribPointer, recordAttribPointer);
+
+      geometry.draw(program, builder.getCount(), builder.getBaseInstance());
+    }
+
+    builder.end();
+
+    const uint32_t location =
+      program.getAttributes().at("normalMatrix").location;
+
+    std::vector<Format> columns;
+    for (const Format &format : formats) {
+      if (format.attribute >= location && format.attribute < location + 3) {
+        columns.push_back(format);
+      }
+    }
+
+    REQUIRE(columns.size() == 3);
+
+    for (uint32_t column = 0; column < 3; column++) {
+      REQUIRE(columns[column].attribute == location + column);
+      REQUIRE(columns[column].size == 3);
+      REQUIRE(columns[column].offset == column * 3 * sizeof(float));
+    }
+  }
+}
@@ -0,0 +1,106 @@
+#include <array>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <catch.hpp>
+#include <stem/MeshOptimizer.hpp>
+
+// build a shuffled grid so triangles are submitted in a cache hostile order
+std::vector<uint32_t> createShuffledGrid(const uint32_t size) {
+  std::vector<std::array<uint32_t, 3>> triangles;
+
+  for (uint32_t y = 0; y < size; y++) {
+    for (uint32_t x = 0; x < size; x++) {
+      const uint32_t corner = y * (size + 1) + x;
+      triangles.push_back({corner, corner + 1, corner + size + 1});
+      triangles.push_back({corner + 1, corner + size + 2, corner + size + 1});
+    }
+  }
+
+  std::shuffle(triangles.begin(), triangles.end(), std::mt19937(7));
+
+  std::vector<uint32_t> indices;
+  for (const auto &triangle : triangles) {
+    indices.insert(indices.end(), triangle.begin(), triangle.end());
+  }
+
+  return indices;
+}
+
+// sort triangles so reordered index buffers can be compared
+std::vector<std::array<uint32_t, 3>> getTriangles(
+  const std::vector<uint32_t> &indices
+) {
+  std::vector<std::array<uint32_t, 3>> triangles;
+
+  for (size_t i = 0; i < indices.size(); i += 3) {
+    // rotate the smallest index first, keeping the winding
+    const size_t first = std::min_element(
+      indices.begin() + i, indices.begin() + i + 3
+    ) - indices.begin() - i;
+
+    triangles.push_back({
+      indices[i + first],
+      indices[i + (first + 1) % 3],
+      indices[i + (first + 2) % 3],
+    });
+  }
+
+  std::sort(triangles.begin(), triangles.end());
+
+  return triangles;
+}
+
+TEST_CASE("stem::MeshOptimizer", "[core]") {
+  const uint32_t size = 32;
+  const uint32_t vertexCount = (size + 1) * (size + 1);
+  std::vector<uint32_t> indices = createShuffledGrid(size);
+  const auto triangles = getTriangles(indices);
+
+  SECTION("analyzeVertexCache: counts fifo misses") {
+    const std::vector<uint32_t> strip = {0, 1, 2, 2, 1, 3, 4, 5, 6};
+    const auto statistics = stem::analyzeVertexCache(strip, 7, 16);
+
+    REQUIRE(statistics.transformed == 7);
+    REQUIRE(statistics.acmr == Approx(7.f / 3));
+    REQUIRE(statistics.atvr == Approx(1));
+  }
+
+  SECTION("optimizeVertexCache: keeps triangles & lowers acmr") {
+    const auto before = stem::analyzeVertexCache(indices, vertexCount);
+    stem::optimizeVertexCache(indices, vertexCount);
+    const auto after = stem::analyzeVertexCache(indices, vertexCount);
+
+    REQUIRE(getTriangles(indices) == triangles);
+    REQUIRE(after.acmr < before.acmr * .6f);
+    REQUIRE(after.atvr < before.atvr);
+  }
+
+  SECTION("optimizeOverdraw: keeps triangles") {
+    std::vector<float> positions;
+    for (uint32_t vertex = 0; vertex < vertexCount; vertex++) {
+      const float x = vertex % (size + 1), y = vertex / (size + 1);
+      positions.insert(positions.end(), {x, y, x * y * .01f});
+    }
+
+    stem::optimizeVertexCache(indices, vertexCount);
+    stem::optimizeOverdraw(indices, positions);
+
+    REQUIRE(getTriangles(indices) == triangles);
+  }
+
+  SECTION("optimizeVertexFetch: renumbers in first use order") {
+    std::vector<uint32_t> fetch = {5, 2, 7, 7, 2, 0};
+    const auto remap = stem::optimizeVertexFetch(fetch, 8);
+
+    REQUIRE(fetch == std::vector<uint32_t>({0, 1, 2, 2, 1, 3}));
+    REQUIRE(remap[5] == 0);
+    REQUIRE(remap[3] == UINT32_MAX);
+
+    const std::vector<float> values = {0, 0, 1, 1, 2, 2, 3, 3,
+                                       4, 4, 5, 5, 6, 6, 7, 7};
+    const auto remapped = stem::remapVertices<float>(values, remap, 2);
+
+    REQUIRE(remapped == std::vector<float>({5, 5, 2, 2, 7, 7, 0, 0}));
+  }
+}
@@ -0,0 +1,117 @@
+#include <cmath>
+#include <vector>
+#include <catch.hpp>
+#include <stem/MeshSimplifier.hpp>
+
+// build a grid with a height function sampled at every vertex
+template <typename Height>
+void createGrid(
+  const uint32_t size,
+  std::vector<uint32_t> &indices,
+  std::vector<float> &positions,
+  Height height
+) {
+  for (uint32_t y = 0; y <= size; y++) {
+    for (uint32_t x = 0; x <= size; x++) {
+      positions.insert(positions.end(), {(float)x, (float)y, height(x, y)});
+    }
+  }
+
+  for (uint32_t y = 0; y < size; y++) {
+    for (uint32_t x = 0; x < size; x++) {
+      const uint32_t corner = y * (size + 1) + x;
+      indices.insert(indices.end(), {corner, corner + 1, corner + size + 1});
+      indices.insert(
+        indices.end(), {corner + 1, corner + size + 2, corner + size + 1}
+      );
+    }
+  }
+}
+
+TEST_CASE("stem::MeshSimplifier", "[core]") {
+  const uint32_t size = 16;
+  std::vector<uint32_t> indices;
+  std::vector<float> positions;
+
+  SECTION("simplify: flat interiors collapse without error") {
+    createGrid(size, indices, positions, [](auto, auto) { return 0.f; });
+
+    const auto simplified = stem::simplify(indices, positions, {});
+
+    // only the locked border ring should remain
+    REQUIRE(simplified.indices.size() < indices.size() / 4);
+    REQUIRE(simplified.error == Approx(0).margin(1e-4));
+
+    std::vector<bool> used(positions.size() / 3, false);
+    for (const uint32_t index : simplified.indices) used[index] = true;
+
+    for (uint32_t i = 0; i <= size; i++) {
+      REQUIRE(used[i]);
+      REQUIRE(used[size * (size + 1) + i]);
+      REQUIRE(used[i * (size + 1)]);
+      REQUIRE(used[i * (size + 1) + size]);
+    }
+  }
+
+  SECTION("simplify: stops at the target error") {
+    createGrid(size, indices, positions, [](uint32_t x, uint32_t y) {
+      return std::sin(x * .7f) * std::cos(y * .5f) * 2;
+    });
+
+    stem::SimplifySettings settings;
+    settings.targetError = .1f;
+    const auto simplified = stem::simplify(indices, positions, settings);
+
+    REQUIRE(simplified.indices.size() < indices.size());
+    REQUIRE(simplified.error <= .1f);
+  }
+
+  SECTION("simplify: attribute weights preserve discontinuities") {
+    createGrid(size, indices, positions, [](auto, auto) { return 0.f; });
+
+    // split the attribute in two halves along x
+    std::vector<float> colors;
+    for (uint32_t vertex = 0; vertex < positions.size() / 3; vertex++) {
+      colors.push_back(vertex % (size + 1) < size / 2 ? 0.f : 1.f);
+    }
+
+    stem::SimplifySettings settings;
+    settings.targetError = .01f;
+    settings.attributes = colors;
+    settings.attributeStride = 1;
+    settings.weights = {1};
+
+    const auto plain = stem::simplify(indices, positions, {});
+    const auto weighted = stem::simplify(indices, positions, settings);
+
+    REQUIRE(weighted.indices.size() > plain.indices.size());
+  }
+
+  SECTION("createLodChain & selectLod: coarser levels further away") {
+    createGrid(size, indices, positions, [](uint32_t x, uint32_t y) {
+      return std::sin(x * .3f) * std::sin(y * .3f) * 4;
+    });
+
+    const auto chain = stem::createLodChain(indices, positions, {}, 4, .5f);
+
+    REQUIRE(chain.levels.size() == 4);
+    REQUIRE(chain.levels[0].range.count == indices.size());
+
+    for (uint32_t level = 1; level < chain.levels.size(); level++) {
+      const auto &previous = chain.levels[level - 1];
+      const auto &current = chain.levels[level];
+
+      const uint32_t end = previous.range.start + previous.range.count;
+
+      REQUIRE(current.range.start == end);
+      REQUIRE(current.range.count < previous.range.count);
+      REQUIRE(current.error >= previous.error);
+    }
+
+    REQUIRE(chain.indices.size() == chain.levels[3].range.start +
+                                      chain.levels[3].range.count);
+
+    REQUIRE(stem::selectLod(chain.levels, 1, 1000) == 0);
+    REQUIRE(stem::selectLod(chain.levels, 1e9f, 1000) == 3);
+  }
+}
@@ -0,0 +1,73 @@
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <catch.hpp>
+#include <stem/MeshletBuilder.hpp>
+
+TEST_CASE("stem::MeshletBuilder", "[core]") {
+  // build a flat grid facing +z
+  const uint32_t size = 24;
+  std::vector<uint32_t> indices;
+  std::vector<float> positions;
+
+  for (uint32_t y = 0; y <= size; y++) {
+    for (uint32_t x = 0; x <= size; x++) {
+      positions.insert(positions.end(), {(float)x, (float)y, 0.f});
+    }
+  }
+
+  for (uint32_t y = 0; y < size; y++) {
+    for (uint32_t x = 0; x < size; x++) {
+      const uint32_t corner = y * (size + 1) + x;
+      indices.insert(indices.end(), {corner, corner + 1, corner + size + 1});
+      indices.insert(
+        indices.end(), {corner + 1, corner + size + 2, corner + size + 1}
+      );
+    }
+  }
+
+  const auto mesh = stem::buildMeshlets(indices, positions, 3, 64);
+
+  SECTION("meshlets cover every triangle once") {
+    REQUIRE(mesh.indices.size() == indices.size());
+    // greedy growth leaves a few partially filled meshlets
+    REQUIRE(mesh.meshlets.size() <= indices.size() / 3 / 64 * 5 / 4);
+
+    uint32_t next = 0;
+    for (const stem::Meshlet &meshlet : mesh.meshlets) {
+      REQUIRE(meshlet.firstIndex == next);
+      REQUIRE(meshlet.count <= 64 * 3);
+      next += meshlet.count;
+    }
+
+    REQUIRE(next == mesh.indices.size());
+
+    // compare triangles regardless of order
+    std::vector<uint32_t> sorted = indices, built = mesh.indices;
+    std::sort(sorted.begin(), sorted.end());
+    std::sort(built.begin(), built.end());
+    REQUIRE(sorted == built);
+  }
+
+  SECTION("meshlets are bounded by their sphere & cone") {
+    for (const stem::Meshlet &meshlet : mesh.meshlets) {
+      for (uint32_t i = 0; i < meshlet.count; i++) {
+        const float *p = &positions[mesh.indices[meshlet.firstIndex + i] * 3];
+        const float distance = std::hypot(
+          p[0] - meshlet.center[0],
+          p[1] - meshlet.center[1],
+          p[2] - meshlet.center[2]
+        );
+
+        REQUIRE(distance <= meshlet.radius + 1e-4f);
+      }
+
+      // flat clusters face +z with a zero width cone
+      REQUIRE(meshlet.axis[2] == Approx(1));
+      REQUIRE(meshlet.cutoff == Approx(0).margin(1e-3));
+
+      // compact clusters stay close to the 8x8 square they could fill
+      REQUIRE(meshlet.radius < 12);
+    }
+  }
+}
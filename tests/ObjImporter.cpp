@@ -0,0 +1,86 @@
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include <catch.hpp>
+#include <stem/ObjImporter.hpp>
+
+TEST_CASE("stem::ObjImporter", "[core]") {
+  SECTION("parseObj: dedups corners & triangulates polygons") {
+    const auto mesh = stem::parseObj(
+      "# quad\r\n"
+      "v 0 0 0\r\n"
+      "v 1.5 0 0\r\n"
+      "v 1.5 2e1 0\r\n"
+      "v 0 20 -.25\r\n"
+      "vt 0 0\nvt 1 1\n"
+      "vn 0 0 1\n"
+      "o ignored\n"
+      "f 1/1/1 2/2/1 3/2/1 4/1/1\n"
+      "f -4/-2/-1 -2/-1/-1 -1/-2/-1\n"
+    );
+
+    REQUIRE(mesh.indices == std::vector<uint32_t>({0, 1, 2, 0, 2, 3, 0, 2, 3}));
+    REQUIRE(mesh.positions.size() == 4 * 3);
+    REQUIRE(mesh.positions[7] == 20);
+    REQUIRE(mesh.positions[11] == -.25f);
+    REQUIRE(mesh.texcoords.size() == 4 * 2);
+    REQUIRE(mesh.normals.size() == 4 * 3);
+    REQUIRE(mesh.normals[2] == 1);
+  }
+
+  SECTION("parseObj: parallel chunks match a single thread") {
+    // a grid large enough to span several chunks, relative faces included
+    std::string source;
+    const uint32_t size = 300;
+
+    for (uint32_t y = 0; y <= size; y++) {
+      for (uint32_t x = 0; x <= size; x++) {
+        source += "v " + std::to_string(x * .125f) + " " +
+                  std::to_string(y * -3.5f) + " 0.000001\n";
+      }
+    }
+
+    for (uint32_t y = 0; y < size; y++) {
+      for (uint32_t x = 0; x < size; x++) {
+        const uint32_t corner = y * (size + 1) + x + 1;
+        source += "f " + std::to_string(corner) + " " +
+                  std::to_string(corner + 1) + " " +
+                  std::to_string(corner + size + 2) + "\n";
+        source += "v 9 9 9\nf -1 " + std::to_string(corner) + " " +
+                  std::to_string(corner + size + 2) + "\n";
+      }
+    }
+
+    const auto single = stem::parseObj(source, 1);
+    const auto parallel = stem::parseObj(source, 4);
+
+    REQUIRE(source.size() > (4u << 20));
+    REQUIRE(single.indices.size() == size * size * 6);
+    // the grid corner at x = 0, y = size is never referenced
+    const uint32_t vertices = (size + 1) * (size + 1) - 1 + size * size;
+    REQUIRE(single.positions.size() == vertices * 3);
+    REQUIRE(single.positions[3] == .125f);
+    REQUIRE(single.indices == parallel.indices);
+    REQUIRE(single.positions == parallel.positions);
+  }
+
+  SECTION("missing vertices & files are rejected") {
+    REQUIRE_THROWS_AS(
+      stem::parseObj("v 0 0 0\nf 1 2 -3\n"), stem::ObjImportError
+    );
+    REQUIRE_THROWS_AS(stem::importObj("missing.obj"), stem::ObjImportError);
+  }
+
+  SECTION("importObj: maps & parses a file") {
+    const std::string path =
+      (std::filesystem::temp_directory_path() / "stem-test.obj").string();
+    std::ofstream(path) << "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n";
+
+    const auto mesh = stem::importObj(path);
+    std::filesystem::remove(path);
+
+    REQUIRE(mesh.indices.size() == 3);
+    REQUIRE(mesh.normals.empty());
+    REQUIRE(mesh.texcoords.empty());
+  }
+}
@@ -29,6 +29,18 @@ TEST_CASE("stem::Program", "[core]") {
     REQUIRE_NOTHROW(stem::Program({.vertex = validShader}));
   }
 
+  SECTION("setUniformBlock: unknown blocks are ignored") {
+    REQUIRE_NOTHROW(program.setUniformBlock("Camera", 0));
+    REQUIRE_NOTHROW(program.setStorageBlock("Lights", 1));
+  }
+
+  SECTION("move: transfers ownership") {
+    const uint32_t id = program.getId();
+    stem::Program moved = std::move(program);
+    REQUIRE(moved.getId() == id);
+    REQUIRE(program.getId() == 0);
+  }
+
   SECTION("destructor: zero id") {
     program.destroy();
     REQUIRE(program.getId() == 0);
@@ -0,0 +1,103 @@
+#include <limits>
+#include <vector>
+#include <catch.hpp>
+#include <stem/Quantize.hpp>
+
+// repeat values so both vectorized bodies & scalar tails are covered
+template <typename Value>
+std::vector<Value> quantizeRepeated(const std::vector<float> &values) {
+  std::vector<float> source;
+  for (uint32_t index = 0; index < 37; index++) {
+    source.insert(source.end(), values.begin(), values.end());
+  }
+
+  std::vector<Value> target(source.size());
+  stem::quantize(source, std::span<Value>(target));
+
+  return target;
+}
+
+TEST_CASE("stem::quantize", "[core]") {
+  SECTION("half: exact, rounded & special values") {
+    const auto halves = quantizeRepeated<stem::Half>(
+      {1.f, -2.f, 65504.f, 1e6f, 0.f, 5.96046448e-8f, 1.00048828f}
+    );
+
+    for (uint32_t index = 0; index < halves.size(); index += 7) {
+      REQUIRE(halves[index].bits == 0x3C00);
+      REQUIRE(halves[index + 1].bits == 0xC000);
+      REQUIRE(halves[index + 2].bits == 0x7BFF);
+      REQUIRE(halves[index + 3].bits == 0x7C00);
+      REQUIRE(halves[index + 4].bits == 0x0000);
+      REQUIRE(halves[index + 5].bits == 0x0001);
+      REQUIRE(halves[index + 6].bits == 0x3C00);
+    }
+  }
+
+  SECTION("snorm16: clamped & rounded") {
+    const auto values = quantizeRepeated<stem::Snorm16>({1.f, -2.f, .5f, 0.f});
+
+    for (uint32_t index = 0; index < values.size(); index += 4) {
+      REQUIRE(values[index].value == 32767);
+      REQUIRE(values[index + 1].value == -32767);
+      REQUIRE(values[index + 2].value == 16384);
+      REQUIRE(values[index + 3].value == 0);
+    }
+  }
+
+  SECTION("unorm16: clamped & rounded") {
+    const auto values = quantizeRepeated<stem::Unorm16>({1.f, -1.f, .5f, 2.f});
+
+    for (uint32_t index = 0; index < values.size(); index += 4) {
+      REQUIRE(values[index].value == 65535);
+      REQUIRE(values[index + 1].value == 0);
+      REQUIRE(values[index + 2].value == 32768);
+      REQUIRE(values[index + 3].value == 65535);
+    }
+  }
+
+  SECTION("snorm8 & unorm8: clamped & rounded") {
+    const auto snorms = quantizeRepeated<stem::Snorm8>({1.f, -1.f, .5f});
+    const auto unorms = quantizeRepeated<stem::Unorm8>({1.f, -1.f, .5f});
+
+    for (uint32_t index = 0; index < snorms.size(); index += 3) {
+      REQUIRE(snorms[index].value == 127);
+      REQUIRE(snorms[index + 1].value == -127);
+      REQUIRE(snorms[index + 2].value == 64);
+      REQUIRE(unorms[index].value == 255);
+      REQUIRE(unorms[index + 1].value == 0);
+      REQUIRE(unorms[index + 2].value == 128);
+    }
+  }
+
+  SECTION("fixed-point: nans convert to the lowest value") {
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+
+    const auto snorms = quantizeRepeated<stem::Snorm16>({nan, .5f});
+    const auto unorms = quantizeRepeated<stem::Unorm16>({nan, .5f});
+    const auto bytes = quantizeRepeated<stem::Snorm8>({nan, .5f});
+
+    for (uint32_t index = 0; index < snorms.size(); index += 2) {
+      REQUIRE(snorms[index].value == -32767);
+      REQUIRE(snorms[index + 1].value == 16384);
+      REQUIRE(unorms[index].value == 0);
+      REQUIRE(unorms[index + 1].value == 32768);
+      REQUIRE(bytes[index].value == -127);
+      REQUIRE(bytes[index + 1].value == 64);
+    }
+
+    const std::vector<float> source = {nan, 0.f, 0.f, 0.f};
+    std::vector<stem::Int2101010> target(1);
+    stem::quantize(source, std::span<stem::Int2101010>(target));
+
+    REQUIRE((target[0].bits & 0x3FFu) == 0x201u);
+  }
+
+  SECTION("int2101010: packed components") {
+    const std::vector<float> source = {1.f, -1.f, 0.f, -1.f};
+    std::vector<stem::Int2101010> target(1);
+    stem::quantize(source, std::span<stem::Int2101010>(target));
+
+    REQUIRE(target[0].bits == (0x1FFu | (0x201u << 10) | (0x3u << 30)));
+  }
+}
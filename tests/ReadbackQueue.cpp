@@ -0,0 +1,89 @@
+#include <vector>
+#include <cstddef>
+#include <catch.hpp>
+#include <stem/Buffer.hpp>
+#include <stem/RingBuffer.hpp>
+#include <stem/ReadbackQueue.hpp>
+
+#include "GLOverride.hpp"
+
+TEST_CASE("stem::ReadbackQueue", "[core]") {
+  stem::ReadbackQueue queue(256);
+
+  const std::vector<uint8_t> bytes = {1, 2, 3};
+  const std::vector<float> values = {0.5f, 1.5f, 2.5f, 3.5f};
+
+  stem::Uint8Buffer byteBuffer(bytes);
+  stem::FloatBuffer floatBuffer(values);
+
+  SECTION("wait: reads back the buffer values") {
+    const auto ticket = queue.request(floatBuffer, 1, 3);
+    REQUIRE(ticket != 0);
+
+    const auto readback = queue.wait<float>(ticket);
+    REQUIRE(std::vector<float>(readback.begin(), readback.end()) ==
+            std::vector<float>(values.begin() + 1, values.end()));
+  }
+
+  SECTION("request: aligns typed ranges after odd sized ones") {
+    const auto first = queue.request(byteBuffer, 0, 3);
+    const auto second = queue.request(floatBuffer, 0, 4);
+
+    const auto readBytes = queue.wait(first);
+    const auto readValues = queue.wait<float>(second);
+
+    REQUIRE(std::vector<uint8_t>(readBytes.begin(), readBytes.end()) == bytes);
+    REQUIRE(std::vector<float>(readValues.begin(), readValues.end()) == values);
+
+    const uintptr_t address = reinterpret_cast<uintptr_t>(readValues.data());
+    REQUIRE(address % alignof(std::max_align_t) == 0);
+
+    // the skipped bytes are held until the readbacks are released
+    REQUIRE(
+      queue.getUsedSize() == alignof(std::max_align_t) + sizeof(float) * 4
+    );
+
+    queue.release(first);
+    queue.release(second);
+    REQUIRE(queue.getUsedSize() == 0);
+  }
+
+  SECTION("request: fails when the staging buffer is full") {
+    std::vector<stem::ReadbackQueue::Ticket> tickets;
+    for (uint32_t i = 0; i < 16; i++) {
+      tickets.push_back(queue.request(floatBuffer, 0, 4));
+    }
+
+    REQUIRE(tickets.back() != 0);
+    REQUIRE(queue.request(byteBuffer, 0, 1) == 0);
+
+    queue.release(tickets.front());
+    REQUIRE(queue.request(byteBuffer, 0, 1) != 0);
+  }
+
+  SECTION("wait: throws when the fence wait fails") {
+    const auto ticket = queue.request(floatBuffer, 0, 4);
+
+    GLOverride wait(glad_glClientWaitSync, failWait);
+    REQUIRE_THROWS_AS(queue.wait(ticket), stem::FenceWaitError);
+    REQUIRE_THROWS_AS(queue.poll(ticket), stem::FenceWaitError);
+  }
+
+  SECTION("poll: returns nothing while the copy is in flight") {
+    const auto ticket = queue.request(floatBuffer, 0, 4);
+
+    {
+      GLOverride wait(glad_glClientWaitSync, expireWait);
+      REQUIRE_FALSE(queue.poll(ticket).has_value());
+    }
+
+    REQUIRE(queue.poll<float>(ticket)->size() == 4);
+  }
+
+  SECTION("constructor: throws when the staging buffer can not be mapped") {
+    GLOverride namedMap(glad_glMapNamedBufferRange, failNamedMap);
+    GLOverride map(glad_glMapBufferRange, failMap);
+
+    REQUIRE_THROWS_AS(stem::ReadbackQueue(64), stem::BufferMapError);
+  }
+}
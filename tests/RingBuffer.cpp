@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <vector>
+#include <catch.hpp>
+#include <stem/RingBuffer.hpp>
+
+#include "GLRead.hpp"
+#include "GLOverride.hpp"
+
+namespace {
+
+/// @brief The number of fence waits since the last reset
+uint32_t waits = 0;
+
+/// @brief The loaded fence wait function
+PFNGLCLIENTWAITSYNCPROC loadedWait = nullptr;
+
+/// @brief Counts fence waits
+GLenum GLAD_API_PTR
+countWait(GLsync fence, GLbitfield flags, GLuint64 timeout) {
+  waits++;
+  return loadedWait(fence, flags, timeout);
+}
+
+} // namespace
+
+TEST_CASE("stem::RingBuffer", "[core]") {
+  // three frame slices of 4 floats
+  stem::FloatRingBuffer ring(4, 3);
+
+  SECTION("map: hands out the frame slices in turn") {
+    for (uint32_t frame = 0; frame < 7; frame++) {
+      const std::span<float> slice = ring.map();
+
+      REQUIRE(slice.size() == 4);
+      REQUIRE(ring.getSize() == 16);
+      REQUIRE(ring.getOffset() == frame % 3 * 16);
+
+      const std::vector<float> values(4, (float)frame);
+      std::copy(values.begin(), values.end(), slice.begin());
+
+      REQUIRE(readBuffer<float>(ring.getId(), ring.getOffset(), 4) == values);
+
+      ring.lock();
+    }
+  }
+
+  SECTION("map: waits for the fence of reused slices only") {
+    waits = 0;
+    loadedWait = glad_glClientWaitSync;
+    GLOverride wait(glad_glClientWaitSync, countWait);
+
+    for (uint32_t frame = 0; frame < 3; frame++) {
+      ring.map();
+      ring.lock();
+    }
+
+    REQUIRE(waits == 0);
+
+    // wrapping around reaches the first fenced slice
+    ring.map();
+    REQUIRE(waits >= 1);
+  }
+
+  SECTION("map: throws when the fence wait fails") {
+    for (uint32_t frame = 0; frame < 3; frame++) {
+      ring.map();
+      ring.lock();
+    }
+
+    {
+      GLOverride wait(glad_glClientWaitSync, failWait);
+      REQUIRE_THROWS_AS(ring.map(), stem::FenceWaitError);
+    }
+
+    // the fence is kept & waited for again
+    REQUIRE(ring.map().size() == 4);
+  }
+
+  SECTION("constructor: throws when the storage can not be mapped") {
+    GLOverride namedMap(glad_glMapNamedBufferRange, failNamedMap);
+    GLOverride map(glad_glMapBufferRange, failMap);
+
+    REQUIRE_THROWS_AS(stem::FloatRingBuffer(4, 3), stem::BufferMapError);
+  }
+}
@@ -0,0 +1,91 @@
+#include <vector>
+#include <numeric>
+#include <catch.hpp>
+#include <stem/Buffer.hpp>
+#include <stem/RingBuffer.hpp>
+#include <stem/UploadQueue.hpp>
+
+#include "GLRead.hpp"
+#include "GLOverride.hpp"
+
+TEST_CASE("stem::UploadQueue", "[core]") {
+  // the staging buffer holds 16 floats
+  stem::UploadQueue queue(64);
+  stem::FloatBuffer target(32, stem::FloatBuffer::Dynamic);
+
+  std::vector<float> values(32);
+  std::iota(values.begin(), values.end(), 1.f);
+
+  SECTION("finish: uploads larger than the staging buffer are resident") {
+    const auto ticket =
+      queue.enqueue(target, 0, std::span<const float>(values));
+
+    queue.finish();
+
+    REQUIRE(queue.isResident(ticket));
+    REQUIRE(queue.getPendingSize() == 0);
+    REQUIRE(readBuffer<float>(target.getId(), 0, 32) == values);
+  }
+
+  SECTION("update: stages at most the byte budget") {
+    queue.enqueue(target, 0, std::span<const float>(values).first(8));
+
+    queue.update(16);
+    REQUIRE(queue.getPendingSize() == 16);
+
+    queue.finish();
+    REQUIRE(queue.getPendingSize() == 0);
+  }
+
+  SECTION("update: waits for staging space while copies are in flight") {
+    const auto ticket =
+      queue.enqueue(target, 0, std::span<const float>(values));
+
+    {
+      GLOverride wait(glad_glClientWaitSync, expireWait);
+
+      // the first batch fills the staging buffer & is never retired
+      queue.update();
+      queue.update();
+
+      REQUIRE(queue.getPendingSize() == 64);
+      REQUIRE_FALSE(queue.isResident(ticket));
+    }
+
+    queue.finish();
+
+    REQUIRE(queue.isResident(ticket));
+    REQUIRE(readBuffer<float>(target.getId(), 0, 32) == values);
+  }
+
+  SECTION("update: wraps around the end of the staging buffer") {
+    const std::span<const float> span(values);
+
+    queue.enqueue(target, 0, span.first(12));
+    queue.finish();
+
+    // 8 floats do not fit the 4 left at the end of the staging buffer
+    const auto ticket = queue.enqueue(target, 12, span.subspan(12, 8));
+    queue.enqueue(target, 20, span.subspan(20, 12));
+    queue.finish();
+
+    REQUIRE(queue.isResident(ticket));
+    REQUIRE(readBuffer<float>(target.getId(), 0, 32) == values);
+  }
+
+  SECTION("update: throws when the fence wait fails") {
+    queue.enqueue(target, 0, std::span<const float>(values).first(4));
+    queue.update();
+
+    GLOverride wait(glad_glClientWaitSync, failWait);
+    REQUIRE_THROWS_AS(queue.update(), stem::FenceWaitError);
+    REQUIRE_THROWS_AS(queue.finish(), stem::FenceWaitError);
+  }
+
+  SECTION("constructor: throws when the staging buffer can not be mapped") {
+    GLOverride namedMap(glad_glMapNamedBufferRange, failNamedMap);
+    GLOverride map(glad_glMapBufferRange, failMap);
+
+    REQUIRE_THROWS_AS(stem::UploadQueue(64), stem::BufferMapError);
+  }
+}
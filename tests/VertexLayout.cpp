@@ -0,0 +1,79 @@
+#include <cstring>
+#include <catch.hpp>
+#include <stem/VertexLayout.hpp>
+
+TEST_CASE("stem::VertexLayout", "[core]") {
+  stem::VertexLayout layout({
+    {.name = "position", .size = 3},
+    {.name = "uv", .size = 2, .type = GL_HALF_FLOAT},
+    {.name = "color", .size = 3, .type = GL_UNSIGNED_BYTE, .normalized = true},
+  });
+
+  SECTION("constructor: offsets are aligned to 4 bytes") {
+    const auto &elements = layout.getElements();
+
+    REQUIRE(elements[0].offset == 0);
+    REQUIRE(elements[1].offset == 12);
+    REQUIRE(elements[2].offset == 16);
+    REQUIRE(layout.getStride() == 20);
+  }
+
+  SECTION("interleave: scatters every source into its element") {
+    std::vector<float> positions(3 * 300);
+    std::vector<uint16_t> uvs(2 * 300);
+    std::vector<uint8_t> colors(3 * 300);
+
+    for (size_t i = 0; i < positions.size(); i++) positions[i] = i;
+    for (size_t i = 0; i < uvs.size(); i++) uvs[i] = i;
+    for (size_t i = 0; i < colors.size(); i++) colors[i] = i;
+
+    const std::vector<uint8_t> vertices =
+      layout.interleave(positions, uvs, colors);
+
+    REQUIRE(vertices.size() == 300 * 20);
+
+    for (uint32_t i = 0; i < 300; i++) {
+      const uint8_t *vertex = vertices.data() + i * 20;
+
+      REQUIRE(std::memcmp(vertex, &positions[i * 3], 12) == 0);
+      REQUIRE(std::memcmp(vertex + 12, &uvs[i * 2], 4) == 0);
+      REQUIRE(std::memcmp(vertex + 16, &colors[i * 3], 3) == 0);
+      REQUIRE(vertex[19] == 0);
+    }
+  }
+
+  SECTION("interleave: mismatching sources throw") {
+    std::vector<float> positions(3 * 4);
+    std::vector<uint16_t> uvs(2 * 3);
+    std::vector<uint8_t> colors(3 * 4);
+
+    REQUIRE_THROWS_AS(
+      layout.interleave(positions, uvs, colors),
+      stem::VertexLayoutError
+    );
+  }
+
+  SECTION("interleave: missing or extra sources throw") {
+    std::vector<float> positions(3 * 4);
+    std::vector<uint16_t> uvs(2 * 4);
+    std::vector<uint8_t> colors(3 * 4);
+
+    REQUIRE_THROWS_AS(
+      layout.interleave(positions, uvs), stem::VertexLayoutError
+    );
+    REQUIRE_THROWS_AS(
+      layout.interleave(positions, uvs, colors, colors),
+      stem::VertexLayoutError
+    );
+  }
+
+  SECTION("interleave: partial values throw") {
+    std::vector<float> positions(3 * 4);
+    std::vector<uint16_t> uvs(2 * 4);
+    std::vector<uint8_t> colors(3 * 4 + 1);
+
+    REQUIRE_THROWS_AS(
+      layout.interleave(positions, uvs, colors), stem::VertexLayoutError
+    );
+  }
+}